@@ -0,0 +1,117 @@
+// Times CollisionSystem::ResolveBulletHits (zombie grid build plus one swept segment query per
+// bullet) over a sweep of bullet and zombie counts, and reports how many bullet/zombie pairs the
+// grid let through to the narrow test against the all-pairs count it replaced.
+#include <SDL2/SDL.h>
+#include "CollisionSystem.h"
+#include "ZombiePool.h"
+#include "ProjectileSystem.h"
+#include "FrameArena.h"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float SPREAD_RADIUS = 1200.0f; // ZombiePool::RECYCLE_DISTANCE
+    constexpr float STEP = 1.0f / 60.0f;
+    constexpr int REPEATS = 50;
+
+    struct Random {
+        uint32_t state;
+        float Next() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        }
+        // Uniform over the disk the pool keeps its zombies in
+        void InDisk(float& x, float& y) {
+            float angle = Next() * 6.2831853f;
+            float distance = std::sqrt(Next()) * SPREAD_RADIUS;
+            x = std::cos(angle) * distance;
+            y = std::sin(angle) * distance;
+        }
+    };
+
+    // Spread over every lane; a lane that is full hands its share to the next type
+    size_t SpawnBullets(ProjectileSystem& projectiles, size_t count, Random& random) {
+        const int typeCount = static_cast<int>(BulletType::COUNT);
+        size_t spawned = 0;
+        for (size_t i = 0; spawned < count && i < count * typeCount; ++i) {
+            float x, y;
+            random.InDisk(x, y);
+            BulletType type = static_cast<BulletType>(i % typeCount);
+            if (!projectiles.Spawn(type, x, y, random.Next() * 360.0f).IsNull()) {
+                spawned++;
+            }
+        }
+        return spawned;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    // Zombie and bullet textures need a renderer; a software one on a surface needs no window
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::fprintf(stderr, "collision_bench: no software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    const size_t zombieCounts[] = {250, 1000, 4000};
+    const size_t bulletCounts[] = {16, 128, 1024};
+    std::printf("%8s %8s %12s %12s %12s %10s\n", "zombies", "bullets", "us/pass", "narrow", "all pairs", "pruned");
+
+    FrameArena frameArena;
+    for (size_t zombieCount : zombieCounts) {
+        ZombiePool zombiePool(renderer, zombieCount);
+        for (size_t i = 0; i < zombieCount; ++i) {
+            zombiePool.AddZombie(); // Filled up front, so GetZombie never grows the pool mid-table
+        }
+        Random random = {7u + static_cast<uint32_t>(zombieCount)};
+        std::vector<Zombie*> zombies;
+        std::vector<float> zombieX(zombieCount), zombieY(zombieCount);
+        for (size_t i = 0; i < zombieCount; ++i) {
+            Zombie* zombie = zombiePool.Resolve(zombiePool.GetZombie());
+            if (!zombie) break;
+            random.InDisk(zombieX[i], zombieY[i]);
+            zombies.push_back(zombie);
+        }
+
+        for (size_t bulletCount : bulletCounts) {
+            ProjectileSystem projectiles(renderer);
+            CollisionSystem collisionSystem;
+            double totalTime = 0.0;
+            size_t narrowTests = 0;
+            size_t bullets = 0;
+            for (int repeat = 0; repeat < REPEATS; ++repeat) {
+                // Hits kill bullets and zombies, so every pass starts from the same crowd
+                for (size_t i = 0; i < zombies.size(); ++i) {
+                    zombies[i]->Reset(zombieX[i], zombieY[i], 1.0f);
+                }
+                projectiles.Clear();
+                Random bulletRandom = {99u + static_cast<uint32_t>(bulletCount)};
+                bullets = SpawnBullets(projectiles, bulletCount, bulletRandom);
+                projectiles.Update(STEP); // One step, so each bullet has a segment to sweep
+
+                frameArena.Reset();
+                Clock::time_point start = Clock::now();
+                collisionSystem.ResolveBulletHits(&projectiles, &zombiePool, &frameArena);
+                totalTime += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+                narrowTests += collisionSystem.GetStats().narrowTests;
+            }
+
+            double allPairs = static_cast<double>(bullets) * zombies.size();
+            double narrow = static_cast<double>(narrowTests) / REPEATS;
+            std::printf("%8zu %8zu %12.1f %12.1f %12.0f %9.0fx\n", zombies.size(), bullets, totalTime / REPEATS,
+                        narrow, allPairs, narrow > 0.0 ? allPairs / narrow : 0.0);
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Times one tick's worth of neighbor queries (every zombie asks for its neighbors) through
+// SpatialGrid against the brute-force scan it replaced, at 250, 1k and 5k zombies.
+#include "SpatialGrid.h"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float QUERY_RADIUS = 104.0f; // Zombie::NEIGHBOR_QUERY_RADIUS
+    constexpr int REPEATS = 20;
+
+    // Uniform over the recycle disk around the player, where the pool keeps its zombies
+    void FillPoints(size_t count, std::vector<float>& xs, std::vector<float>& ys) {
+        uint32_t state = 7u + static_cast<uint32_t>(count);
+        auto next = [&state]() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        };
+        xs.resize(count);
+        ys.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            float angle = next() * 6.2831853f;
+            float distance = std::sqrt(next()) * 1200.0f;
+            xs[i] = std::cos(angle) * distance;
+            ys[i] = std::sin(angle) * distance;
+        }
+    }
+
+    double Microseconds(Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+}
+
+int main() {
+    const size_t counts[] = {250, 1000, 5000};
+    std::printf("%8s %12s %12s %12s %10s\n", "zombies", "build us", "grid us", "brute us", "speedup");
+
+    for (size_t count : counts) {
+        std::vector<float> xs, ys;
+        FillPoints(count, xs, ys);
+        SpatialGrid grid(QUERY_RADIUS);
+        std::vector<int> candidates;
+        candidates.reserve(count);
+        size_t checksum = 0; // Keeps the loops from being optimized away
+
+        double buildTime = 0.0;
+        double gridTime = 0.0;
+        double bruteTime = 0.0;
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            Clock::time_point start = Clock::now();
+            grid.Build(xs.data(), ys.data(), count);
+            buildTime += Microseconds(start);
+
+            // Grid: candidates, then the same exact distance test the brute force does
+            start = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                candidates.clear();
+                grid.Query(xs[i], ys[i], QUERY_RADIUS, candidates);
+                for (int j : candidates) {
+                    float dx = xs[j] - xs[i];
+                    float dy = ys[j] - ys[i];
+                    checksum += dx * dx + dy * dy <= QUERY_RADIUS * QUERY_RADIUS;
+                }
+            }
+            gridTime += Microseconds(start);
+
+            start = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t j = 0; j < count; ++j) {
+                    float dx = xs[j] - xs[i];
+                    float dy = ys[j] - ys[i];
+                    checksum -= dx * dx + dy * dy <= QUERY_RADIUS * QUERY_RADIUS;
+                }
+            }
+            bruteTime += Microseconds(start);
+        }
+
+        // Both paths count the same neighbors, so the checksum comes back to zero
+        std::printf("%8zu %12.1f %12.1f %12.1f %9.1fx%s\n", count, buildTime / REPEATS, gridTime / REPEATS,
+                    bruteTime / REPEATS, bruteTime / gridTime, checksum == 0 ? "" : "  (MISMATCH)");
+    }
+    return 0;
+}
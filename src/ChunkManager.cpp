@@ -1,13 +1,17 @@
 #include "include/ChunkManager.h"
 #include <iostream>
 #include <cmath>
-#include <thread> // Ensure thread is included for std::this_thread::sleep_for
-#include <chrono> // Ensure chrono is included for std::chrono::milliseconds
+#include <cstdlib>
+#include <algorithm>
 
 ChunkManager::ChunkManager(SDL_Renderer* renderer, Player* player, const std::string& baseMapPath, const std::string& baseTilesetPath)
     : renderer(renderer), player(player), baseMapPath(baseMapPath), baseTilesetPath(baseTilesetPath),
-      blueprintTileMap(nullptr), currentPlayerChunkCoord({0,0}), 
-      chunkWidthPixels(0), chunkHeightPixels(0), viewDistanceChunks(1) { // Default view distance to 1 chunk around player
+      blueprintTileMap(nullptr), frameArena(nullptr), currentPlayerChunkCoord({0,0}), 
+      chunkWidthPixels(0), chunkHeightPixels(0), viewDistanceChunks(1), // Default view distance to 1 chunk around player
+      viewDistanceX(1), viewDistanceY(1), lastViewDistanceX(1), lastViewDistanceY(1), loader(nullptr), loadsRefused(false),
+      lastPlayerX(0.0f), lastPlayerY(0.0f), hasLastPlayerPosition(false), velocityX(0.0f), velocityY(0.0f),
+      prefetching(false), lookAheadChunkCoord({0,0}), lastPrefetching(false), lastLookAheadChunkCoord({0,0}),
+      notReadyEvents(0) {
 
     // Create a blueprint tilemap to get dimensions and for loading new chunks
     blueprintTileMap = new TileMap(renderer);
@@ -26,27 +30,23 @@ ChunkManager::ChunkManager(SDL_Renderer* renderer, Player* player, const std::st
     if (chunkWidthPixels == 0 || chunkHeightPixels == 0) {
         std::cerr << "ChunkManager: Blueprint map has zero dimensions!" << std::endl;
     }
-    
+
+    loader = new ChunkLoader([this](ChunkCoord coord) { return CreateChunk(coord); });
     UpdateActiveChunks(); 
 }
 
 ChunkManager::~ChunkManager() {
-    // Wait for any pending loading tasks to complete
-    for (auto& task_pair : loadingTasks) {
-        if (task_pair.second.valid()) {
-            task_pair.second.wait(); // Wair the background thread complete
-        }
+    // Stops the workers (loads in progress finish first) and frees chunks nobody collected.
+    // Goes first: the workers read the blueprint.
+    if (loader) {
+        delete loader;
+        loader = nullptr;
     }
-    loadingTasks.clear();
-
-    // Clear any chunks that were loaded but not yet activated
-    {
-        std::lock_guard<std::mutex> lock(readyChunksMutex); //Lock the mutex to safely access readyToActivateChunks without data race
-        for (auto& pair : readyToActivateChunks) {
-            delete pair.second; // Delete TileMap instance
-        }
-        readyToActivateChunks.clear();
+    pendingChunks.clear();
+    for (auto& pair : decodedChunks) {
+        delete pair.second;
     }
+    decodedChunks.clear();
 
     for (auto& pair : activeChunks) {
         delete pair.second; // Delete TileMap instance
@@ -59,7 +59,7 @@ ChunkManager::~ChunkManager() {
     }
 }
 
-ChunkCoord ChunkManager::GetChunkCoordFromWorldPos(float worldX, float worldY) {
+ChunkCoord ChunkManager::GetChunkCoordFromWorldPos(float worldX, float worldY) const {
     if (chunkWidthPixels == 0 || chunkHeightPixels == 0) {
         return {0,0};
     }
@@ -68,43 +68,47 @@ ChunkCoord ChunkManager::GetChunkCoordFromWorldPos(float worldX, float worldY) {
     return {chunkX, chunkY}; // Chunk coordinates
 }
 
+TileMap* ChunkManager::CreateChunk(ChunkCoord coord) const {
+    TileMap* newChunk = new TileMap(renderer);
+    // Decode only: the SDL renderer must not be touched off the main thread, so the texture is
+    // created later by UploadDecodedChunks
+    if (!newChunk->DecodeTileset(baseTilesetPath.c_str())) {
+        std::cerr << "Thread: Failed to load tileset for chunk (" << coord.x << "," << coord.y << ")" << std::endl;
+        delete newChunk;
+        return nullptr;
+    }
+    // Every chunk is the same CSV, so share the blueprint's tiles instead of parsing it again
+    newChunk->ShareMap(*blueprintTileMap);
+    return newChunk;
+}
+
+float ChunkManager::GetLoadPriority(const ChunkCoord& coord) const {
+    // Squared distance in chunks from the player's chunk: the ring the player stands next to comes in first
+    float dx = static_cast<float>(coord.x - currentPlayerChunkCoord.x);
+    float dy = static_cast<float>(coord.y - currentPlayerChunkCoord.y);
+    float priority = dx * dx + dy * dy;
+    // Look-ahead chunks only once everything required is on its way
+    return IsInWindow(coord) ? priority : PREFETCH_PRIORITY + priority;
+}
+
 void ChunkManager::LoadChunk(int chunkGridX, int chunkGridY) {
     ChunkCoord coord = {chunkGridX, chunkGridY};
 
-    if (activeChunks.count(coord) || loadingTasks.count(coord)) {
+    if (activeChunks.count(coord) || decodedChunks.count(coord)) {
         return;
     }
 
-    if (!blueprintTileMap || chunkWidthPixels == 0 || chunkHeightPixels == 0) {
+    if (!loader || !blueprintTileMap || chunkWidthPixels == 0 || chunkHeightPixels == 0) {
         std::cerr << "ChunkManager: Cannot start load chunk, blueprint not ready." << std::endl;
         return;
     }
-    //Force run on a separate thread
-    // This is a simple example of using std::async to run the loading in a separate thread.
-    loadingTasks[coord] = std::async(std::launch::async, [this, chunkGridX, chunkGridY, coord]() {
-        TileMap* newChunk = new TileMap(this->renderer); 
-
-        
 
-        bool success = true;
-        // SDL_CreateTextureFromSurface should ideally be on the main thread.
-        // For this example, we are calling it here. If issues arise, this is a key area to refactor.
-        if (!newChunk->LoadTileset(this->baseTilesetPath.c_str())) {
-            std::cerr << "Thread: Failed to load tileset for chunk (" << chunkGridX << "," << chunkGridY << ")" << std::endl;
-            success = false;
-        }
-        if (success && !newChunk->LoadMap(this->baseMapPath.c_str())) {
-            std::cerr << "Thread: Failed to load map data for chunk (" << chunkGridX << "," << chunkGridY << ")" << std::endl;
-            success = false;
-        }
-
-        if (success) {
-            std::lock_guard<std::mutex> lock(this->readyChunksMutex);
-            this->readyToActivateChunks.push_back({coord, newChunk});
-        } else {
-            delete newChunk; 
-        }
-    });
+    // A full loader is not an error: UpdateActiveChunks asks again next frame
+    if (loader->Request(coord, GetLoadPriority(coord))) {
+        pendingChunks.insert(coord);
+    } else {
+        loadsRefused = true;
+    }
 }
 
 void ChunkManager::UnloadChunk(int chunkGridX, int chunkGridY) {
@@ -117,80 +121,184 @@ void ChunkManager::UnloadChunk(int chunkGridX, int chunkGridY) {
 }
 
 void ChunkManager::ProcessReadyChunks() {
-    std::vector<std::pair<ChunkCoord, TileMap*>> toActivateNow;
-    {
-        std::lock_guard<std::mutex> lock(readyChunksMutex);
-        if (!readyToActivateChunks.empty()) {
-            toActivateNow.swap(readyToActivateChunks);
+    if (!loader) return;
+
+    ChunkLoader::Result result;
+    while (loader->PopResult(result)) {
+        ChunkCoord coord = result.coord;
+        TileMap* chunk = result.chunk;
+        pendingChunks.erase(coord); // Collected, whatever the outcome
+
+        bool stillNeeded = chunk && IsWanted(coord);
+
+        if (stillNeeded && !activeChunks.count(coord) && !decodedChunks.count(coord)) {
+            decodedChunks[coord] = chunk;
+        } else {
+            delete chunk; // Failed, no longer in the window, or a duplicate load
         }
     }
+}
 
-    for (const auto& pair : toActivateNow) {
-        ChunkCoord coord = pair.first;
-        TileMap* chunk = pair.second;
-        loadingTasks.erase(coord); // Remove from loading tasks map once processed, regardless of outcome
-
-        bool stillNeeded = false;
-        for (int yOffset = -viewDistanceChunks; yOffset <= viewDistanceChunks; ++yOffset) {
-            for (int xOffset = -viewDistanceChunks; xOffset <= viewDistanceChunks; ++xOffset) {
-                if (currentPlayerChunkCoord.x + xOffset == coord.x && currentPlayerChunkCoord.y + yOffset == coord.y) {
-                    stillNeeded = true;
-                    break;
-                }
+void ChunkManager::UploadDecodedChunks() {
+    size_t bytesLeft = UPLOAD_BYTES_PER_FRAME;
+    bool uploadedAny = false;
+    while (!decodedChunks.empty()) {
+        // Few chunks wait at once, so a scan for the nearest is cheaper than keeping them sorted
+        auto nearest = decodedChunks.end();
+        for (auto it = decodedChunks.begin(); it != decodedChunks.end(); ++it) {
+            if (!IsWanted(it->first)) continue;
+            if (nearest == decodedChunks.end() || GetLoadPriority(it->first) < GetLoadPriority(nearest->first)) {
+                nearest = it;
             }
-            if (stillNeeded) break;
         }
+        if (nearest == decodedChunks.end()) break;
 
-        if (stillNeeded) {
-            if (activeChunks.find(coord) == activeChunks.end()) { 
-                activeChunks[coord] = chunk;
-            } else {
-                delete chunk; 
-            }
+        TileMap* chunk = nearest->second;
+        size_t bytes = chunk->GetUploadBytes();
+        if (uploadedAny && bytes > bytesLeft) break;
+        bytesLeft -= std::min(bytes, bytesLeft);
+        uploadedAny = true;
+
+        ChunkCoord coord = nearest->first;
+        decodedChunks.erase(nearest);
+        if (chunk->UploadTileset()) {
+            activeChunks[coord] = chunk;
         } else {
+            std::cerr << "ChunkManager: Failed to upload tileset for chunk (" << coord.x << "," << coord.y << ")" << std::endl;
             delete chunk;
         }
     }
 
-    auto it_futures = loadingTasks.begin();
-    while (it_futures != loadingTasks.end()) {
-        if (it_futures->second.valid() && 
-            it_futures->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            // Future is ready, meaning the task finished (or threw an exception handled by std::async)
-            // We attempt to get the result to clear the future's state and catch exceptions if any were propagated.
-            try {
-                it_futures->second.get(); 
-            } catch (const std::exception& e) {
-                std::cerr << "Exception from loading task for chunk (" << it_futures->first.x << "," << it_futures->first.y << "): " << e.what() << std::endl;
-            }
-            it_futures = loadingTasks.erase(it_futures); 
+    // Chunks that left the window while waiting are never uploaded
+    for (auto it = decodedChunks.begin(); it != decodedChunks.end();) {
+        if (!IsWanted(it->first)) {
+            delete it->second;
+            it = decodedChunks.erase(it);
         } else {
-            ++it_futures;
+            ++it;
+        }
+    }
+}
+
+void ChunkManager::FillBlockedCells(float originX, float originY, float cellSize, int cols, int rows,
+                                    std::vector<Uint8>& blocked) const {
+    blocked.assign(static_cast<size_t>(cols) * rows, 0);
+    if (!blueprintTileMap || chunkWidthPixels == 0 || chunkHeightPixels == 0) return;
+
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            float worldX = originX + (col + 0.5f) * cellSize;
+            float worldY = originY + (row + 0.5f) * cellSize;
+            ChunkCoord coord = GetChunkCoordFromWorldPos(worldX, worldY);
+            if (blueprintTileMap->IsBlockedAt(worldX - coord.x * chunkWidthPixels,
+                                              worldY - coord.y * chunkHeightPixels)) {
+                blocked[row * cols + col] = 1;
+            }
+        }
+    }
+}
+
+bool ChunkManager::IsInWindow(const ChunkCoord& coord) const {
+    return std::abs(coord.x - currentPlayerChunkCoord.x) <= viewDistanceX &&
+           std::abs(coord.y - currentPlayerChunkCoord.y) <= viewDistanceY;
+}
+
+bool ChunkManager::IsInPrefetchWindow(const ChunkCoord& coord) const {
+    return prefetching &&
+           std::abs(coord.x - lookAheadChunkCoord.x) <= viewDistanceX &&
+           std::abs(coord.y - lookAheadChunkCoord.y) <= viewDistanceY;
+}
+
+void ChunkManager::UpdatePrefetch(float deltaTime) {
+    if (!player || deltaTime <= 0.0f) return;
+
+    float playerX = player->GetX();
+    float playerY = player->GetY();
+    if (hasLastPlayerPosition) {
+        velocityX += ((playerX - lastPlayerX) / deltaTime - velocityX) * VELOCITY_SMOOTHING;
+        velocityY += ((playerY - lastPlayerY) / deltaTime - velocityY) * VELOCITY_SMOOTHING;
+    }
+    lastPlayerX = playerX;
+    lastPlayerY = playerY;
+    hasLastPlayerPosition = true;
+
+    if (velocityX * velocityX + velocityY * velocityY < MIN_PREFETCH_SPEED * MIN_PREFETCH_SPEED) {
+        prefetching = false;
+        return;
+    }
+    ChunkCoord playerChunk = GetChunkCoordFromWorldPos(playerX, playerY);
+    lookAheadChunkCoord = GetChunkCoordFromWorldPos(playerX + velocityX * PREFETCH_SECONDS,
+                                                    playerY + velocityY * PREFETCH_SECONDS);
+    prefetching = lookAheadChunkCoord.x != playerChunk.x || lookAheadChunkCoord.y != playerChunk.y;
+}
+
+void ChunkManager::CountNotReadyVisible(Camera* camera) {
+    if (!camera || chunkWidthPixels == 0 || chunkHeightPixels == 0) return;
+
+    ChunkCoord first = GetChunkCoordFromWorldPos(camera->GetX(), camera->GetY());
+    ChunkCoord last = GetChunkCoordFromWorldPos(camera->GetX() + camera->GetWorldViewWidth(),
+                                                camera->GetY() + camera->GetWorldViewHeight());
+    // Same x-then-y order as ChunkCoord::operator<, so the list comes out sorted
+    notReadyScratch.clear();
+    for (int x = first.x; x <= last.x; ++x) {
+        for (int y = first.y; y <= last.y; ++y) {
+            ChunkCoord coord = {x, y};
+            if (activeChunks.find(coord) == activeChunks.end()) {
+                notReadyScratch.push_back(coord);
+            }
+        }
+    }
+
+    // A chunk counts once when it shows up missing, not on every update it stays missing
+    for (const ChunkCoord& coord : notReadyScratch) {
+        if (!std::binary_search(notReadyCoords.begin(), notReadyCoords.end(), coord)) {
+            notReadyEvents++;
         }
     }
+    notReadyCoords.swap(notReadyScratch);
+}
+
+ChunkManager::StreamingStats ChunkManager::GetStreamingStats() const {
+    return {notReadyEvents, notReadyCoords.size(), loader ? loader->GetQueuedCount() : 0,
+            decodedChunks.size(), prefetching};
+}
+
+void ChunkManager::UpdateViewDistance(Camera* camera) {
+    if (!camera || chunkWidthPixels == 0 || chunkHeightPixels == 0) return;
+
+    // Half the visible world, rounded up to whole chunks, plus the chunk the player stands in
+    int neededX = static_cast<int>(std::ceil(camera->GetWorldViewWidth() / 2.0f / chunkWidthPixels));
+    int neededY = static_cast<int>(std::ceil(camera->GetWorldViewHeight() / 2.0f / chunkHeightPixels));
+    viewDistanceX = std::max(viewDistanceChunks, neededX);
+    viewDistanceY = std::max(viewDistanceChunks, neededY);
 }
 
 void ChunkManager::UpdateActiveChunks() {
     if (!player || chunkWidthPixels == 0 || chunkHeightPixels == 0) return;
 
     ChunkCoord newPlayerChunkCoord = GetChunkCoordFromWorldPos(player->GetX(), player->GetY());
+    bool prefetchChanged = prefetching != lastPrefetching ||
+        (prefetching && (lookAheadChunkCoord.x != lastLookAheadChunkCoord.x || lookAheadChunkCoord.y != lastLookAheadChunkCoord.y));
 
     if (newPlayerChunkCoord.x != currentPlayerChunkCoord.x || 
         newPlayerChunkCoord.y != currentPlayerChunkCoord.y || 
-        activeChunks.empty()) {
+        activeChunks.empty() || loadsRefused || prefetchChanged ||
+        lastViewDistanceX != viewDistanceX || lastViewDistanceY != viewDistanceY) {
         
         currentPlayerChunkCoord = newPlayerChunkCoord;
+        lastPrefetching = prefetching;
+        lastLookAheadChunkCoord = lookAheadChunkCoord;
+        loadsRefused = false;
+        lastViewDistanceX = viewDistanceX;
+        lastViewDistanceY = viewDistanceY;
 
-        std::map<ChunkCoord, bool> requiredChunks;
-        for (int yOffset = -viewDistanceChunks; yOffset <= viewDistanceChunks; ++yOffset) {
-            for (int xOffset = -viewDistanceChunks; xOffset <= viewDistanceChunks; ++xOffset) {
-                requiredChunks[{currentPlayerChunkCoord.x + xOffset, currentPlayerChunkCoord.y + yOffset}] = true;
-            }
-        }
-
-        std::vector<ChunkCoord> toUnload;
+        // The required chunks are exactly the window around the player, so membership is
+        // IsInWindow and no set has to be built. Only the unload list needs storage, and it
+        // lives in the frame arena.
+        FrameVector<ChunkCoord> toUnload{FrameAllocator<ChunkCoord>(frameArena)};
+        toUnload.reserve(activeChunks.size());
         for (const auto& pair : activeChunks) {
-            if (requiredChunks.find(pair.first) == requiredChunks.end()) {
+            if (!IsWanted(pair.first)) {
                 toUnload.push_back(pair.first);
             }
         }
@@ -198,23 +306,70 @@ void ChunkManager::UpdateActiveChunks() {
             UnloadChunk(coord.x, coord.y);
         }
 
-        for (const auto& pair : requiredChunks) {
-            // Only attempt to load if not active AND not already being loaded
-            if (activeChunks.find(pair.first) == activeChunks.end() && loadingTasks.find(pair.first) == loadingTasks.end()) {
-                LoadChunk(pair.first.x, pair.first.y); 
+        // Loads still queued for chunks that left the window are dropped before they start
+        FrameVector<ChunkCoord> toCancel{FrameAllocator<ChunkCoord>(frameArena)};
+        for (const auto& coord : pendingChunks) {
+            if (!IsWanted(coord) && loader && loader->Cancel(coord)) {
+                toCancel.push_back(coord);
+            }
+        }
+        for (const auto& coord : toCancel) {
+            pendingChunks.erase(coord);
+        }
+
+        // Queue the missing chunks; ones already queued get their priority refreshed for the
+        // player's new chunk, so the workers always take the nearest first
+        for (int xOffset = -viewDistanceX; xOffset <= viewDistanceX; ++xOffset) {
+            for (int yOffset = -viewDistanceY; yOffset <= viewDistanceY; ++yOffset) {
+                LoadChunk(currentPlayerChunkCoord.x + xOffset, currentPlayerChunkCoord.y + yOffset);
+            }
+        }
+        // Then the look-ahead window, which GetLoadPriority puts behind all of the above
+        if (prefetching) {
+            for (int xOffset = -viewDistanceX; xOffset <= viewDistanceX; ++xOffset) {
+                for (int yOffset = -viewDistanceY; yOffset <= viewDistanceY; ++yOffset) {
+                    ChunkCoord coord = {lookAheadChunkCoord.x + xOffset, lookAheadChunkCoord.y + yOffset};
+                    if (!IsInWindow(coord)) {
+                        LoadChunk(coord.x, coord.y);
+                    }
+                }
             }
         }
     }
 }
 
-void ChunkManager::Update(float deltaTime) {
+void ChunkManager::Update(float deltaTime, Camera* camera) {
+    UpdateViewDistance(camera);
+    UpdatePrefetch(deltaTime);
     ProcessReadyChunks();
+    UploadDecodedChunks();
     UpdateActiveChunks();
+    CountNotReadyVisible(camera);
+}
+
+int ChunkManager::SelectLodLevel(float zoom) {
+    // Pick the level whose resolution is closest without going below the screen's:
+    // zoom 0.5 -> level 1 (half size), 0.25 -> level 2, and so on
+    int level = 0;
+    float scale = 1.0f;
+    while (level + 1 < TileMap::GetLodLevelCount() && zoom <= scale * 0.5f) {
+        scale *= 0.5f;
+        ++level;
+    }
+    return level;
 }
 
 void ChunkManager::Render(Camera* camera) {
     if (!camera || chunkWidthPixels == 0 || chunkHeightPixels == 0) return;
 
+    int lodLevel = SelectLodLevel(camera->GetZoom());
+    int bakesLeft = MAX_LOD_BAKES_PER_FRAME;
+
+    float viewLeft = camera->GetX();
+    float viewTop = camera->GetY();
+    float viewRight = viewLeft + camera->GetWorldViewWidth();
+    float viewBottom = viewTop + camera->GetWorldViewHeight();
+
     for (const auto& pair : activeChunks) {
         ChunkCoord coord = pair.first;
         TileMap* chunk = pair.second;
@@ -222,6 +377,19 @@ void ChunkManager::Render(Camera* camera) {
         int worldOffsetX = coord.x * chunkWidthPixels;
         int worldOffsetY = coord.y * chunkHeightPixels;
 
-        chunk->Render(camera, worldOffsetX, worldOffsetY);
+        // Skip chunks entirely outside the view
+        if (worldOffsetX + chunkWidthPixels < viewLeft || worldOffsetX > viewRight ||
+            worldOffsetY + chunkHeightPixels < viewTop || worldOffsetY > viewBottom) {
+            continue;
+        }
+
+        if (lodLevel == 0) {
+            chunk->ReleaseLods(-1); // Back at full detail, the baked textures are just memory
+            chunk->Render(camera, worldOffsetX, worldOffsetY);
+        } else if (chunk->HasLod(lodLevel) || bakesLeft-- > 0) {
+            chunk->RenderLod(camera, worldOffsetX, worldOffsetY, lodLevel);
+        } else {
+            chunk->Render(camera, worldOffsetX, worldOffsetY); // Not baked yet, draw tiles this frame
+        }
     }
 }
@@ -1,6 +1,9 @@
 #include "include/UI.h"
 #include "include/Constants.h" // Add Constants.h for dynamic window dimensions
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdarg>
 #include <iomanip>
 #include <chrono>
 #include <ctime>
@@ -12,8 +15,10 @@ UI::UI(SDL_Renderer* renderer) : renderer(renderer), font(nullptr),
     barFillColor({0, 255, 0, 255}),          // Green
     barBackgroundColor({255, 0, 0, 255}),    // Red
     ammoTexture(nullptr), healthTexture(nullptr), waveInfoTexture(nullptr),
-    notificationTexture(nullptr), notificationTimer(0.0f)
+    notificationTexture(nullptr), notificationTimer(0.0f), frameArena(nullptr)
 {
+    formatFallback[0] = '\0';
+    notificationText.reserve(NOTIFICATION_RESERVE);
     std::cout << "UI constructor called" << std::endl;
     LoadHighScores();
     std::cout << "After LoadHighScores, highScores.size() = " << highScores.size() << std::endl;
@@ -70,6 +75,23 @@ SDL_Texture* UI::CreateTextTexture(const std::string& text) {
 }
 
 SDL_Texture* UI::CreateTextTexture(const std::string& text, SDL_Color color, int fontSize) {
+    return CreateTextTexture(text.c_str(), color, fontSize);
+}
+
+const char* UI::FormatText(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const char* text = formatFallback;
+    if (frameArena) {
+        text = frameArena->FormatV(format, args);
+    } else {
+        std::vsnprintf(formatFallback, sizeof(formatFallback), format, args);
+    }
+    va_end(args);
+    return text;
+}
+
+SDL_Texture* UI::CreateTextTexture(const char* text, SDL_Color color, int fontSize) {
     // If we need a different font size, create a temporary font
     TTF_Font* renderFont = font;
     bool tempFont = false;
@@ -83,7 +105,7 @@ SDL_Texture* UI::CreateTextTexture(const std::string& text, SDL_Color color, int
         }
     }
     
-    SDL_Surface* surface = TTF_RenderText_Blended(renderFont, text.c_str(), color);
+    SDL_Surface* surface = TTF_RenderText_Blended(renderFont, text, color);
     if (!surface) {
         SDL_Log("Failed to render text surface! SDL_ttf Error: %s\n", TTF_GetError());
         if (tempFont) {
@@ -108,27 +130,31 @@ SDL_Texture* UI::CreateTextTexture(const std::string& text, SDL_Color color, int
 }
 
 void UI::UpdateTextTextures(int currentHealth, int maxHealth, int currentAmmo, int maxAmmo) {
-    std::stringstream healthText, ammoText;
-    
     // Update health text
-    healthText << "Health: " << currentHealth << "/" << maxHealth;
-    if (healthTexture) {
-        SDL_DestroyTexture(healthTexture);
+    const char* healthText = FormatText("Health: %d/%d", currentHealth, maxHealth);
+    if (!healthTexture || healthTextShown != healthText) {
+        if (healthTexture) {
+            SDL_DestroyTexture(healthTexture);
+        }
+        healthTexture = CreateTextTexture(healthText, textColor);
+        healthTextShown = healthText;   // Reuses the string's capacity once it has grown
+        SDL_QueryTexture(healthTexture, nullptr, nullptr, &healthRect.w, &healthRect.h);
+        healthRect.x = MARGIN_X;
+        healthRect.y = MARGIN_Y - healthRect.h - TEXT_SPACING;// Adjusted to be above the health bar
     }
-    healthTexture = CreateTextTexture(healthText.str());
-    SDL_QueryTexture(healthTexture, nullptr, nullptr, &healthRect.w, &healthRect.h);
-    healthRect.x = MARGIN_X;
-    healthRect.y = MARGIN_Y - healthRect.h - TEXT_SPACING;// Adjusted to be above the health bar
 
     // Update ammo text
-    ammoText << "Ammo: " << currentAmmo << "/" << maxAmmo;
-    if (ammoTexture) {
-        SDL_DestroyTexture(ammoTexture);
+    const char* ammoText = FormatText("Ammo: %d/%d", currentAmmo, maxAmmo);
+    if (!ammoTexture || ammoTextShown != ammoText) {
+        if (ammoTexture) {
+            SDL_DestroyTexture(ammoTexture);
+        }
+        ammoTexture = CreateTextTexture(ammoText, textColor);
+        ammoTextShown = ammoText;
+        SDL_QueryTexture(ammoTexture, nullptr, nullptr, &ammoRect.w, &ammoRect.h);
+        ammoRect.x = MARGIN_X;
+        ammoRect.y = MARGIN_Y + BAR_HEIGHT + TEXT_SPACING;// Adjusted to be below the health bar
     }
-    ammoTexture = CreateTextTexture(ammoText.str());
-    SDL_QueryTexture(ammoTexture, nullptr, nullptr, &ammoRect.w, &ammoRect.h);
-    ammoRect.x = MARGIN_X;
-    ammoRect.y = MARGIN_Y + BAR_HEIGHT + TEXT_SPACING;// Adjusted to be below the health bar
 }
 
 void UI::RenderHealthBar(int currentHealth, int maxHealth) {
@@ -164,6 +190,10 @@ void UI::RenderAmmoCounter(int currentAmmo, int maxAmmo) {
 }
 
 void UI::ShowNotification(const std::string& text) {
+    ShowNotification(text.c_str());
+}
+
+void UI::ShowNotification(const char* text) {
     notificationText = text;
     notificationTimer = NOTIFICATION_DURATION;
     
@@ -173,7 +203,7 @@ void UI::ShowNotification(const std::string& text) {
     }
     
     // Create new texture
-    notificationTexture = CreateTextTexture(text);
+    notificationTexture = CreateTextTexture(text, textColor);
     if (notificationTexture) {        
         int w, h;
         SDL_QueryTexture(notificationTexture, nullptr, nullptr, &w, &h);
@@ -211,24 +241,30 @@ void UI::RenderNotification() {
 }
 
 void UI::UpdateWaveInfo(int currentWave, int zombiesRemaining, float spawnTimer) {
-    // Clean up old texture
-    if (waveInfoTexture) {
-        SDL_DestroyTexture(waveInfoTexture);
-        waveInfoTexture = nullptr;
-    }
-
     // Format wave info text
-    std::stringstream ss;
+    const char* waveText;
     if (zombiesRemaining <= 0) {
         /// If no zombies remaining, show next wave info
-        ss << "Wave " << currentWave << " | Next Wave in " << std::fixed << std::setprecision(1) << spawnTimer << "s";
+        waveText = FormatText("Wave %d | Next Wave in %.1fs", currentWave, spawnTimer);
     } else {
         // During wave, just show wave number
-        ss << "Wave " << currentWave;
+        waveText = FormatText("Wave %d", currentWave);
+    }
+
+    // Runs every tick, but the text only changes a few times a second
+    if (waveInfoTexture && waveInfoTextShown == waveText) {
+        return;
+    }
+
+    // Clean up old texture
+    if (waveInfoTexture) {
+        SDL_DestroyTexture(waveInfoTexture);
+        waveInfoTexture = nullptr;
     }
 
     // Create new texture
-    waveInfoTexture = CreateTextTexture(ss.str());
+    waveInfoTexture = CreateTextTexture(waveText, textColor);
+    waveInfoTextShown = waveText;
     if (waveInfoTexture) {
         int w, h;
         SDL_QueryTexture(waveInfoTexture, nullptr, nullptr, &w, &h);        // Center horizontally at top of screen
@@ -241,6 +277,18 @@ void UI::UpdateWaveInfo(int currentWave, int zombiesRemaining, float spawnTimer)
     }
 }
 
+int UI::RenderDebugText(const char* text, int x, int y) {
+    static const SDL_Color DEBUG_COLOR = {255, 255, 0, 255};
+    SDL_Texture* texture = CreateTextTexture(text, DEBUG_COLOR, DEBUG_FONT_SIZE);
+    if (!texture) return 0;
+
+    SDL_Rect rect = {x, y, 0, 0};
+    SDL_QueryTexture(texture, nullptr, nullptr, &rect.w, &rect.h);
+    SDL_RenderCopy(renderer, texture, nullptr, &rect);
+    SDL_DestroyTexture(texture);
+    return rect.h;
+}
+
 void UI::RenderWaveInfo() {
     if (waveInfoTexture) {
         SDL_RenderCopy(renderer, waveInfoTexture, nullptr, &waveInfoRect);
@@ -341,9 +389,8 @@ void UI::RenderGameOverScreen(int waveReached) {
     SDL_Color statsColor = {255, 255, 255, 255}; // White
     
     // Wave reached
-    std::stringstream waveText;
-    waveText << "Wave Reached: " << waveReached;
-    SDL_Texture* waveTexture = CreateTextTexture(waveText.str(), statsColor, 36);
+    const char* waveText = FormatText("Wave Reached: %d", waveReached);
+    SDL_Texture* waveTexture = CreateTextTexture(waveText, statsColor, 36);
     
     if (waveTexture) {
         int textWidth, textHeight;
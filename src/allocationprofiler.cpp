@@ -0,0 +1,110 @@
+#include "include/AllocationProfiler.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    constexpr int SUBSYSTEM_COUNT = static_cast<int>(AllocationProfiler::Subsystem::COUNT);
+
+    struct Counter {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    Counter currentFrame[SUBSYSTEM_COUNT];
+    AllocationProfiler::Counts lastFrame[SUBSYSTEM_COUNT];
+
+    // Plain int so it is usable from operator new before any constructor has run
+    thread_local int currentScope = static_cast<int>(AllocationProfiler::Subsystem::BACKGROUND);
+
+    const char* const NAMES[SUBSYSTEM_COUNT] = {
+        "General", "Player", "Waves", "Zombies", "Collision", "Effects", "Chunks", "UI", "Render", "Background"
+    };
+}
+
+#ifdef ALLOCATION_PROFILER
+namespace {
+    void Record(std::size_t size) {
+        Counter& counter = currentFrame[currentScope];
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+void* operator new(std::size_t size) {
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+    Record(size);
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer) Record(size);
+    return pointer;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+AllocationProfiler::Scope::Scope(Subsystem subsystem) : previous(currentScope) {
+    currentScope = static_cast<int>(subsystem);
+}
+
+AllocationProfiler::Scope::~Scope() {
+    currentScope = previous;
+}
+#endif
+
+namespace AllocationProfiler {
+
+bool IsEnabled() {
+#ifdef ALLOCATION_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SetMainThread() {
+    currentScope = static_cast<int>(Subsystem::GENERAL);
+}
+
+void BeginFrame() {
+    for (int i = 0; i < SUBSYSTEM_COUNT; ++i) {
+        lastFrame[i].allocations = currentFrame[i].allocations.exchange(0, std::memory_order_relaxed);
+        lastFrame[i].bytes = currentFrame[i].bytes.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+Counts GetLastFrame(Subsystem subsystem) {
+    return lastFrame[static_cast<int>(subsystem)];
+}
+
+Counts GetLastFrameTotal(bool includeBackground) {
+    Counts total;
+    for (int i = 0; i < SUBSYSTEM_COUNT; ++i) {
+        if (!includeBackground && i == static_cast<int>(Subsystem::BACKGROUND)) continue;
+        total.allocations += lastFrame[i].allocations;
+        total.bytes += lastFrame[i].bytes;
+    }
+    return total;
+}
+
+const char* GetName(Subsystem subsystem) {
+    return NAMES[static_cast<int>(subsystem)];
+}
+
+}
@@ -1,10 +1,12 @@
 #include "include/Camera.h" // Adjusted path based on typical project structure
 #include <algorithm> // For std::min, std::max
+#include <cmath>
 
 // Constructor
 Camera::Camera(float startX, float startY, int screenW, int screenH)
     : x(startX), y(startY), viewWidth(screenW), viewHeight(screenH),
-      followSpeed(5.0f) // Adjust this value to change camera follow responsiveness.
+      followSpeed(5.0f), // Adjust this value to change camera follow responsiveness.
+      zoom(1.0f)
 {}
 
 Camera::~Camera() {}
@@ -24,8 +26,8 @@ void Camera::SetPosition(float newX, float newY) {
 //pass in the player coordinates
 void Camera::Update(float targetCenterX, float targetCenterY, float deltaTime) {
     // Calculate the desired top-left position for the camera to center the target.
-    float desiredX = targetCenterX - viewWidth / 2.0f;
-    float desiredY = targetCenterY - viewHeight / 2.0f;
+    float desiredX = targetCenterX - GetWorldViewWidth() / 2.0f;
+    float desiredY = targetCenterY - GetWorldViewHeight() / 2.0f;
 
     // Smoothly interpolate the camera's current position towards the desired position.
     // The factor std::min(followSpeed * deltaTime, 1.0f) ensures that the camera
@@ -41,11 +43,33 @@ void Camera::Update(float targetCenterX, float targetCenterY, float deltaTime) {
 }
 
 SDL_FPoint Camera::WorldToScreen(float worldX, float worldY) const {
-    return {worldX - x, worldY - y};
+    return {(worldX - x) * zoom, (worldY - y) * zoom};
 }
 
 SDL_FPoint Camera::ScreenToWorld(float screenX, float screenY) const {
-    return {screenX + x, screenY + y};
+    return {screenX / zoom + x, screenY / zoom + y};
+}
+
+void Camera::SetZoom(float newZoom) {
+    newZoom = std::max(MIN_ZOOM, std::min(newZoom, MAX_ZOOM));
+    if (newZoom == zoom) return;
+
+    // Keep the world point under the screen center in place
+    float centerX = x + GetWorldViewWidth() / 2.0f;
+    float centerY = y + GetWorldViewHeight() / 2.0f;
+    zoom = newZoom;
+    x = centerX - GetWorldViewWidth() / 2.0f;
+    y = centerY - GetWorldViewHeight() / 2.0f;
+}
+
+float Camera::GetWorldViewRadius() const {
+    float width = GetWorldViewWidth();
+    float height = GetWorldViewHeight();
+    return 0.5f * std::sqrt(width * width + height * height);
+}
+
+float Camera::GetDistanceScale() const {
+    return std::max(1.0f, GetWorldViewRadius() / REFERENCE_VIEW_RADIUS);
 }
 
 void Camera::SetViewDimensions(int width, int height) {
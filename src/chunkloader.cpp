@@ -0,0 +1,115 @@
+#include "include/ChunkLoader.h"
+#include "include/TileMap.h"
+#include <algorithm>
+#include <iostream>
+
+ChunkLoader::ChunkLoader(LoadFunc load, unsigned threadCount, size_t capacity)
+    : load(std::move(load)), nextTicket(0), stopping(false),
+      capacity(capacity), inFlight(0), results(capacity) {
+    for (unsigned i = 0; i < std::max(1u, threadCount); ++i) {
+        workers.emplace_back(&ChunkLoader::WorkerLoop, this);
+    }
+}
+
+ChunkLoader::~ChunkLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queuedJobs.clear();  // Nothing new starts; loads already running finish first
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    Result result;
+    while (results.Pop(result)) {
+        delete result.chunk;
+    }
+}
+
+bool ChunkLoader::Request(ChunkCoord coord, float priority) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (loadingNow.count(coord)) return true;
+
+        auto it = queuedJobs.find(coord);
+        if (it == queuedJobs.end()) {
+            if (inFlight.load() >= capacity) return false;
+            inFlight++;
+        } else if (it->second.priority == priority) {
+            return true;
+        }
+
+        Job job = {priority, nextTicket++, coord};
+        queuedJobs[coord] = job;
+        jobs.push(job);
+        if (jobs.size() > 4 * capacity) {
+            RebuildJobHeap();
+        }
+    }
+    wakeCondition.notify_one();
+    return true;
+}
+
+bool ChunkLoader::Cancel(ChunkCoord coord) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queuedJobs.erase(coord) == 0) return false;
+    inFlight--;
+    return true;
+}
+
+bool ChunkLoader::PopResult(Result& result) {
+    if (!results.Pop(result)) return false;
+    inFlight--;
+    return true;
+}
+
+size_t ChunkLoader::GetQueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queuedJobs.size();
+}
+
+void ChunkLoader::RebuildJobHeap() {
+    std::priority_queue<Job, std::vector<Job>, LoadsLater> live;
+    for (const auto& pair : queuedJobs) {
+        live.push(pair.second);
+    }
+    jobs.swap(live);
+}
+
+void ChunkLoader::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            job = jobs.top();
+            jobs.pop();
+            auto it = queuedJobs.find(job.coord);
+            if (it == queuedJobs.end() || it->second.ticket != job.ticket) continue; // Cancelled or re-queued
+            queuedJobs.erase(it);
+            loadingNow.insert(job.coord);
+        }
+
+        TileMap* chunk = nullptr;
+        try {
+            chunk = load(job.coord);
+        } catch (const std::exception& e) {
+            std::cerr << "ChunkLoader: Exception loading chunk (" << job.coord.x << "," << job.coord.y << "): " << e.what() << std::endl;
+        }
+
+        // Out of loadingNow first: a request made after the result is collected must queue a new
+        // load rather than wait on this one. A request in between may load the chunk twice, and
+        // the caller drops the spare.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loadingNow.erase(job.coord);
+        }
+        results.Push({job.coord, chunk});
+    }
+}
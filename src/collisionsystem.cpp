@@ -0,0 +1,102 @@
+#include "include/CollisionSystem.h"
+#include "include/Zombie.h"
+#include "include/ZombiePool.h"
+#include "include/ParticleSystem.h"
+#include "include/LightMap.h"
+#include <algorithm>
+#include <chrono>
+
+CollisionSystem::CollisionSystem()
+    : particleSystem(nullptr), lightMap(nullptr), stats{0, 0, 0, 0.0f},
+      zombieGrid(CELL_SIZE), queryRadius(0.0f) {
+}
+
+void CollisionSystem::BuildZombieGrid(const ZombiePool* zombiePool) {
+    zombies.clear();
+    centerX.clear();
+    centerY.clear();
+    queryRadius = 0.0f;
+    // Sized to the pool rather than the live count, so the buffers only grow when the pool does
+    size_t capacity = zombiePool->GetStats().capacity;
+    zombies.reserve(capacity);
+    centerX.reserve(capacity);
+    centerY.reserve(capacity);
+    candidates.reserve(capacity);
+    zombieGrid.Reserve(capacity);
+    for (Zombie* zombie : zombiePool->GetActiveZombies()) {
+        if (zombie->IsDead()) continue;
+        SDL_Rect hitbox = zombie->GetHitbox();
+        zombies.push_back(zombie);
+        centerX.push_back(hitbox.x + hitbox.w * 0.5f);
+        centerY.push_back(hitbox.y + hitbox.h * 0.5f);
+        queryRadius = std::max(queryRadius, 0.5f * std::max(hitbox.w, hitbox.h));
+    }
+    queryRadius += ProjectileSystem::BULLET_SIZE * 0.5f;
+    zombieGrid.Build(centerX.data(), centerY.data(), zombies.size());
+}
+
+Zombie* CollisionSystem::FindHit(float x0, float y0, float x1, float y1, float& hitTime) {
+    candidates.clear();
+    zombieGrid.QuerySegment(x0, y0, x1, y1, queryRadius, candidates);
+    // Ascending and unique, so on a tie the zombie earlier in the active list wins
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    const float halfSize = ProjectileSystem::BULLET_SIZE * 0.5f;
+    Zombie* earliest = nullptr;
+    hitTime = 1.0f;
+    for (int index : candidates) {
+        Zombie* zombie = zombies[index];
+        stats.narrowTests++;
+        float time;
+        // Dead ones are skipped inside: an earlier bullet this tick may have killed it
+        if (zombie->IntersectBulletPath(x0, y0, x1, y1, halfSize, time) && (!earliest || time < hitTime)) {
+            earliest = zombie;
+            hitTime = time;
+        }
+    }
+    return earliest;
+}
+
+void CollisionSystem::ResolveBulletHits(ProjectileSystem* projectiles, ZombiePool* zombiePool, FrameArena* frameArena) {
+    if (!projectiles || !zombiePool) return;
+    auto start = std::chrono::steady_clock::now();
+
+    stats.narrowTests = 0;
+    stats.bullets = projectiles->GetCount();
+    BuildZombieGrid(zombiePool);
+    stats.zombies = zombies.size();
+
+    // Hits are killed by handle after the walk, so the lanes never shift under it
+    FrameVector<ProjectileHandle> hits{FrameAllocator<ProjectileHandle>(frameArena)};
+    if (!zombies.empty()) {
+        for (int typeIndex = 0; typeIndex < static_cast<int>(BulletType::COUNT); ++typeIndex) {
+            BulletType type = static_cast<BulletType>(typeIndex);
+            const ProjectileLane& lane = projectiles->GetLane(type);
+            for (size_t i = 0; i < lane.count; ++i) {
+                // The whole step is tested, so a fast bullet cannot skip over a zombie's edge
+                float hitTime;
+                Zombie* zombie = FindHit(lane.prevX[i], lane.prevY[i], lane.x[i], lane.y[i], hitTime);
+                if (!zombie) continue;
+
+                float hitX = lane.prevX[i] + (lane.x[i] - lane.prevX[i]) * hitTime;
+                float hitY = lane.prevY[i] + (lane.y[i] - lane.prevY[i]) * hitTime;
+                // Knockback points from the impact towards the zombie
+                zombie->TakeDamage(zombie->GetX() - hitX, zombie->GetY() - hitY, type);
+
+                if (particleSystem) {
+                    particleSystem->EmitImpact(hitX, hitY, lane.rotation[i], type == BulletType::SHOTGUN_PELLET);
+                }
+                if (lightMap) {
+                    lightMap->AddFlash(hitX, hitY, 70.0f, {255, 140, 50, 255}, 0.1f);
+                }
+                hits.push_back(projectiles->GetHandle(type, i));
+            }
+        }
+    }
+    for (ProjectileHandle hit : hits) {
+        projectiles->Kill(hit);
+    }
+
+    stats.microseconds = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
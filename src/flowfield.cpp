@@ -0,0 +1,196 @@
+#include "include/FlowField.h"
+#include "include/ChunkManager.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <functional>
+
+FlowField::FlowField()
+    : requestPending(false), backReady(false), stopping(false),
+      tickCount(0), publishTick(0), jobInFlight(false), stagingPending(false),
+      hasRequested(false), requestedCellX(0), requestedCellY(0) {
+    worker = std::thread(&FlowField::WorkerLoop, this);
+}
+
+FlowField::~FlowField() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void FlowField::Update(float playerX, float playerY, const ChunkManager* chunks) {
+    tickCount++;
+    if (jobInFlight && tickCount >= publishTick) {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this]() { return backReady; });
+        std::swap(front, back);
+        backReady = false;
+        jobInFlight = false;
+    }
+
+    if (!chunks) return;
+
+    int cellX = static_cast<int>(std::floor(playerX / CELL_SIZE));
+    int cellY = static_cast<int>(std::floor(playerY / CELL_SIZE));
+    if (!hasRequested || cellX != requestedCellX || cellY != requestedCellY) {
+        hasRequested = true;
+        requestedCellX = cellX;
+        requestedCellY = cellY;
+
+        // Chunks are only touched on the main thread, so the walkable cells are copied out here.
+        // A goal staged while a job is in flight is simply replaced by a newer one.
+        staging.originCellX = cellX - RADIUS_CELLS;
+        staging.originCellY = cellY - RADIUS_CELLS;
+        staging.goalCellX = cellX;
+        staging.goalCellY = cellY;
+        chunks->FillBlockedCells(staging.originCellX * CELL_SIZE, staging.originCellY * CELL_SIZE,
+                                 CELL_SIZE, SIZE_CELLS, SIZE_CELLS, staging.blocked);
+        stagingPending = true;
+    }
+
+    if (stagingPending && !jobInFlight) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(request, staging);
+            requestPending = true;
+        }
+        wakeCondition.notify_one();
+        stagingPending = false;
+        jobInFlight = true;
+        publishTick = tickCount + PUBLISH_LATENCY_TICKS;
+    }
+}
+
+void FlowField::WorkerLoop() {
+    Field working;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [this]() { return stopping || requestPending; });
+            if (stopping) return;
+            std::swap(working, request);
+            requestPending = false;
+        }
+
+        Build(working);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(back, working);
+            backReady = true;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void FlowField::Build(Field& field) {
+    const int cellCount = SIZE_CELLS * SIZE_CELLS;
+    field.cost.assign(cellCount, UNREACHABLE);
+    field.dirX.assign(cellCount, 0.0f);
+    field.dirY.assign(cellCount, 0.0f);
+    field.lineOfSight.assign(cellCount, 0);
+    field.valid = false;
+    if (static_cast<int>(field.blocked.size()) != cellCount) return;
+
+    static const int OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    auto isOpen = [&field](int x, int y) {
+        return x >= 0 && y >= 0 && x < SIZE_CELLS && y < SIZE_CELLS && !field.blocked[y * SIZE_CELLS + x];
+    };
+    // Diagonal steps may not cut the corner of a blocked cell
+    auto canStep = [&isOpen](int x, int y, int offsetX, int offsetY) {
+        if (!isOpen(x + offsetX, y + offsetY)) return false;
+        return offsetX == 0 || offsetY == 0 || (isOpen(x + offsetX, y) && isOpen(x, y + offsetY));
+    };
+
+    // Dijkstra outward from the player's cell (the player can stand where the map says blocked)
+    int goalX = field.goalCellX - field.originCellX;
+    int goalY = field.goalCellY - field.originCellY;
+    using Entry = std::pair<int, int>;  // cost, cell index
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    field.cost[goalY * SIZE_CELLS + goalX] = 0;
+    open.push({0, goalY * SIZE_CELLS + goalX});
+    while (!open.empty()) {
+        Entry entry = open.top();
+        open.pop();
+        int cellX = entry.second % SIZE_CELLS;
+        int cellY = entry.second / SIZE_CELLS;
+        if (entry.first > field.cost[entry.second]) continue;  // Stale entry
+
+        for (const auto& offset : OFFSETS) {
+            if (!canStep(cellX, cellY, offset[0], offset[1])) continue;
+            int next = (cellY + offset[1]) * SIZE_CELLS + cellX + offset[0];
+            int nextCost = entry.first + (offset[0] != 0 && offset[1] != 0 ? DIAGONAL_COST : STRAIGHT_COST);
+            if (nextCost < field.cost[next]) {
+                field.cost[next] = nextCost;
+                open.push({nextCost, next});
+            }
+        }
+    }
+
+    // Each reachable cell points at its cheapest neighbor
+    for (int cellY = 0; cellY < SIZE_CELLS; ++cellY) {
+        for (int cellX = 0; cellX < SIZE_CELLS; ++cellX) {
+            int index = cellY * SIZE_CELLS + cellX;
+            if (field.cost[index] == UNREACHABLE) continue;
+            if (HasLineOfSight(field, cellX, cellY)) {
+                field.lineOfSight[index] = 1;
+                continue;
+            }
+
+            int bestCost = field.cost[index];
+            float bestX = 0.0f, bestY = 0.0f;
+            for (const auto& offset : OFFSETS) {
+                if (!canStep(cellX, cellY, offset[0], offset[1])) continue;
+                int neighborCost = field.cost[(cellY + offset[1]) * SIZE_CELLS + cellX + offset[0]];
+                if (neighborCost < bestCost) {
+                    bestCost = neighborCost;
+                    bestX = static_cast<float>(offset[0]);
+                    bestY = static_cast<float>(offset[1]);
+                }
+            }
+            float length = std::sqrt(bestX * bestX + bestY * bestY);
+            if (length > 0) {
+                field.dirX[index] = bestX / length;
+                field.dirY[index] = bestY / length;
+            }
+        }
+    }
+    field.valid = true;
+}
+
+bool FlowField::HasLineOfSight(const Field& field, int fromX, int fromY) {
+    // Walk the segment between cell centers in half-cell steps; any blocked cell breaks the line
+    int goalX = field.goalCellX - field.originCellX;
+    int goalY = field.goalCellY - field.originCellY;
+    float deltaX = static_cast<float>(goalX - fromX);
+    float deltaY = static_cast<float>(goalY - fromY);
+    int steps = static_cast<int>(std::ceil(std::max(std::fabs(deltaX), std::fabs(deltaY)) * 2.0f));
+    for (int step = 1; step < steps; ++step) {
+        float t = static_cast<float>(step) / steps;
+        int cellX = static_cast<int>(std::floor(fromX + 0.5f + deltaX * t));
+        int cellY = static_cast<int>(std::floor(fromY + 0.5f + deltaY * t));
+        if (field.blocked[cellY * SIZE_CELLS + cellX]) return false;
+    }
+    return true;
+}
+
+bool FlowField::Sample(float x, float y, float& dirX, float& dirY) const {
+    if (!front.valid) return false;
+
+    int cellX = static_cast<int>(std::floor(x / CELL_SIZE)) - front.originCellX;
+    int cellY = static_cast<int>(std::floor(y / CELL_SIZE)) - front.originCellY;
+    if (cellX < 0 || cellY < 0 || cellX >= SIZE_CELLS || cellY >= SIZE_CELLS) return false;
+
+    int index = cellY * SIZE_CELLS + cellX;
+    if (front.cost[index] == UNREACHABLE || front.lineOfSight[index]) return false;
+
+    dirX = front.dirX[index];
+    dirY = front.dirY[index];
+    return true;
+}
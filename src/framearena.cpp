@@ -0,0 +1,84 @@
+#include "include/FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+FrameArena::FrameArena(size_t initialCapacity)
+    : block(nullptr), capacity(initialCapacity), offset(0),
+      fallbackBytes(0), lastFrameBytes(0), fallbackCount(0) {
+    block = static_cast<char*>(::operator new(capacity));
+    fallbacks.reserve(64);
+}
+
+FrameArena::~FrameArena() {
+    for (void* pointer : fallbacks) {
+        ::operator delete(pointer);
+    }
+    ::operator delete(block);
+    block = nullptr;
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(block);
+    uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    size_t start = static_cast<size_t>(aligned - base);
+    if (start + bytes <= capacity) {
+        offset = start + bytes;
+        return block + start;
+    }
+
+    // Out of room: serve this frame from the heap and let Reset size the block up
+    fallbackBytes += bytes;
+    fallbackCount++;
+    void* pointer = ::operator new(bytes);
+    fallbacks.push_back(pointer);
+    return pointer;
+}
+
+void FrameArena::Deallocate(void* pointer, size_t bytes) {
+    if (!pointer || !Owns(pointer)) return;
+    // Popping the latest allocation lets a growing vector reuse the space it just left
+    char* bytesStart = static_cast<char*>(pointer);
+    if (bytesStart + bytes == block + offset) {
+        offset = static_cast<size_t>(bytesStart - block);
+    }
+}
+
+void FrameArena::Reset() {
+    lastFrameBytes = offset + fallbackBytes;
+    for (void* pointer : fallbacks) {
+        ::operator delete(pointer);
+    }
+    fallbacks.clear();
+    if (fallbackBytes > 0) {
+        // Every allocation of the frame is gone by now, so the block can be replaced
+        size_t newCapacity = std::max(capacity * 2, lastFrameBytes + lastFrameBytes / 2);
+        ::operator delete(block);
+        block = static_cast<char*>(::operator new(newCapacity));
+        capacity = newCapacity;
+        std::cout << "FrameArena: Grew to " << capacity / 1024 << " KB" << std::endl;
+    }
+    offset = 0;
+    fallbackBytes = 0;
+}
+
+const char* FrameArena::Format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const char* text = FormatV(format, args);
+    va_end(args);
+    return text;
+}
+
+const char* FrameArena::FormatV(const char* format, va_list args) {
+    va_list measureArgs;
+    va_copy(measureArgs, args);
+    int length = std::vsnprintf(nullptr, 0, format, measureArgs);
+    va_end(measureArgs);
+    if (length < 0) return "";
+
+    char* text = static_cast<char*>(Allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, format, args);
+    return text;
+}
@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <cassert>
 
 Game::Game() : 
     isRunning(false), 
@@ -21,10 +22,24 @@ Game::Game() :
     ui(nullptr),
     camera(nullptr),
     chunkManager(nullptr),
+    flowField(nullptr),
     zombiePool(nullptr),
+    particleSystem(nullptr),
+    lightMap(nullptr),
+    collisionSystem(nullptr),
+    simulation(nullptr),
+    frameArena(nullptr),
+    checkAllocations(false),
+    steadyFrames(0),
+    allocationFailures(0),
+    scriptedWaves(0),
+    scriptedFrames(0),
+    scriptedRunCompleted(false),
+    fixedSeed(0),
+    hasFixedSeed(false),
+    currentSpawnPoint(0),
     waveManager(nullptr),
     loadingScreen(nullptr) {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
 }
 
 Game::~Game() {
@@ -60,11 +75,15 @@ bool Game::Initialize() {
     Constants::WINDOW_HEIGHT = actualHeight;
     
     // Display message confirming fullscreen mode
-    std::cout << "Game running in fullscreen mode at " << Constants::WINDOW_WIDTH << "x" << Constants::WINDOW_HEIGHT << std::endl;    renderer = SDL_CreateRenderer(
-        window,
-        -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-    );    if (!renderer) {
+    std::cout << "Game running in fullscreen mode at " << Constants::WINDOW_WIDTH << "x" << Constants::WINDOW_HEIGHT << std::endl;    // A scripted run goes as fast as it can render, so it does not wait for vsync
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | (scriptedWaves > 0 ? 0 : SDL_RENDERER_PRESENTVSYNC);
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+    if (!renderer) {
+        // Headless video drivers and some VMs only have the software renderer
+        std::cerr << "Accelerated renderer unavailable (" << SDL_GetError() << "), using software" << std::endl;
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
+    if (!renderer) {
         std::cerr << "Renderer creation failed: " << SDL_GetError() << std::endl;
         return false;
     }
@@ -94,8 +113,12 @@ bool Game::Initialize() {
     // Initialize the loading screen AFTER TTF initialization
     loadingScreen = std::make_unique<LoadingScreen>(renderer);
     
+    // Lives as long as the game; the UI and chunk manager format and sort into it every frame
+    frameArena = new FrameArena();
+
     // Initialize UI first since MainMenu needs it for high scores
     ui = new UI(renderer);
+    ui->SetFrameArena(frameArena);
     if (!ui->Initialize()) {
         std::cerr << "UI initialization failed" << std::endl;
         return false;
@@ -179,30 +202,53 @@ void Game::InitializeGameState() {
         loadingScreen->Render(0.0f, "Initializing game components...");
         // Create and initialize UI first (doesn't depend on other components)
         ui = new UI(renderer);
+        ui->SetFrameArena(frameArena);
         if (!ui->Initialize()) {
             throw std::runtime_error("UI initialization failed");
         }
         loadingScreen->Render(0.1f, "Creating user interface...");
+
+        // Everything random in the run draws from streams derived from this one seed
+        uint64_t seed = hasFixedSeed ? fixedSeed : static_cast<uint64_t>(std::time(nullptr));
+        simulation = new Simulation(seed);
+        spawnPoints.clear();
+        currentSpawnPoint = 0;
+        std::cout << "Game: Simulation seed " << seed << std::endl;
         
         // Create temporary wave manager just for player initialization
         // Will be replaced with the real one later
         waveManager = new WaveManager();
           // Create player instance
         player = new Player(renderer, waveManager, ui);
+        player->SetRandom(&simulation->GetRandom(RandomStream::WEAPONS));
         loadingScreen->Render(0.2f, "Creating player...");// Create camera instance
         camera = new Camera(player->GetX() - Constants::WINDOW_WIDTH / 2.0f + player->GetDestRect().w / 2.0f, 
                           player->GetY() - Constants::WINDOW_HEIGHT / 2.0f + player->GetDestRect().h / 2.0f, 
                           Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT);
         loadingScreen->Render(0.4f, "Creating camera...");
+
+        // Particle pools are allocated once here so firing never allocates
+        particleSystem = new ParticleSystem(renderer);
+        particleSystem->SetRandom(&simulation->GetRandom(RandomStream::PARTICLES));
+        player->SetParticleSystem(particleSystem);
+        lightMap = new LightMap(renderer);
+        player->SetLightMap(lightMap);
+        collisionSystem = new CollisionSystem();
+        collisionSystem->SetParticleSystem(particleSystem);
+        collisionSystem->SetLightMap(lightMap);
         
         // Initialize chunk manager
         chunkManager = new ChunkManager(renderer, player, "assets/maps/grasstiles.csv", "assets/tilesets/Grass 13  .png");
+        chunkManager->SetFrameArena(frameArena);
         loadingScreen->Render(0.5f, "Loading map chunks...");
         
         // Initialize zombie pool with loading updates
         std::cout << "Game: Creating zombie pool..." << std::endl;
         loadingScreen->Render(0.6f, "Creating zombie pool...");        // Create zombies gradually to show progress
         zombiePool = new ZombiePool(renderer, ZOMBIE_POOL_SIZE);
+        flowField = new FlowField();
+        zombiePool->SetFlowField(flowField);
+        zombiePool->SetSimulation(simulation);
         for(size_t i = 0; i < ZOMBIE_POOL_SIZE; i++) {        
             zombiePool->AddZombie(); // Add zombies one by one
             if(i % 10 == 0 || i == ZOMBIE_POOL_SIZE - 1) { // Update progress every 10 zombies and at the end
@@ -216,6 +262,7 @@ void Game::InitializeGameState() {
         
         // Replace temporary wave manager with final one now that all systems are ready
         WaveManager* finalWaveManager = new WaveManager();
+        finalWaveManager->SetRandom(&simulation->GetRandom(RandomStream::WAVES));
         
         // Update player with the final wave manager
         if (player) {
@@ -276,6 +323,14 @@ void Game::HandleEvents() {
                     // Convert screen mouse coordinates to world coordinates for the player
                     SDL_FPoint worldMousePos = camera->ScreenToWorld(static_cast<float>(event.motion.x), static_cast<float>(event.motion.y));
                     player->UpdateMousePosition(static_cast<int>(worldMousePos.x), static_cast<int>(worldMousePos.y));
+                } else if (event.type == SDL_MOUSEWHEEL && camera && player) {
+                    // Scroll up zooms in, scroll down zooms out
+                    camera->SetZoom(camera->GetZoom() * std::pow(Camera::ZOOM_STEP, static_cast<float>(event.wheel.y)));
+                    // The world point under the cursor moved, re-aim at it
+                    int mouseX, mouseY;
+                    SDL_GetMouseState(&mouseX, &mouseY);
+                    SDL_FPoint worldMousePos = camera->ScreenToWorld(static_cast<float>(mouseX), static_cast<float>(mouseY));
+                    player->UpdateMousePosition(static_cast<int>(worldMousePos.x), static_cast<int>(worldMousePos.y));
                 } else if (player) {
                     player->HandleInput(event);
                 }
@@ -368,8 +423,9 @@ void Game::Update(float deltaTime) {    switch (currentState) {
                 mainMenu->Reset();
             }
             break;
-        case GameState::PLAYING:
+        case GameState::PLAYING: {
             // Regular game update logic
+            AllocationProfiler::Scope playerScope(AllocationProfiler::Subsystem::PLAYER);
             if (player) {
                 player->Update(deltaTime);
                 // Check if player died
@@ -390,10 +446,12 @@ void Game::Update(float deltaTime) {    switch (currentState) {
             
             // Update wave manager and UI
             if (waveManager) {
+                AllocationProfiler::Scope wavesScope(AllocationProfiler::Subsystem::WAVES);
                 waveManager->Update(deltaTime);
                 
                 // Update UI with wave info
                 if (ui) {
+                    AllocationProfiler::Scope uiScope(AllocationProfiler::Subsystem::UI);
                     ui->UpdateWaveInfo(
                         waveManager->GetCurrentWave(),
                         waveManager->GetZombiesRemaining(),
@@ -403,6 +461,7 @@ void Game::Update(float deltaTime) {    switch (currentState) {
                 
                 // Check for weapon unlocks and display notifications
                 if (ui && waveManager->HasNewWeaponUnlock()) {
+                    AllocationProfiler::Scope uiScope(AllocationProfiler::Subsystem::UI);
                     int currentWave = waveManager->GetCurrentWave();
                     if (currentWave == WaveConfig::RIFLE_UNLOCK_WAVE) {
                         ui->ShowNotification("Rifle Unlocked! Press 2 to equip");
@@ -425,39 +484,27 @@ void Game::Update(float deltaTime) {    switch (currentState) {
 
             // Update UI notifications
             if (ui) {
-                ui->UpdateNotification(deltaTime);            }
+                AllocationProfiler::Scope uiScope(AllocationProfiler::Subsystem::UI);
+                ui->UpdateNotification(deltaTime);
+            }
 
             // Update zombies through the pool
+            // Publish the last finished flow field before zombies read it
+            if (flowField && player) {
+                AllocationProfiler::Scope zombiesScope(AllocationProfiler::Subsystem::ZOMBIES);
+                flowField->Update(player->GetX(), player->GetY(), chunkManager);
+            }
+
             if (zombiePool) {
-                zombiePool->Update(deltaTime, player);                // Check collision with player's bullets
-                auto& bullets = player->GetBullets();
-                for (auto bulletIt = bullets.begin(); bulletIt != bullets.end();) {
-                    Bullet* bullet = *bulletIt;
-                    if (!bullet->IsActive()) {
-                        ++bulletIt;
-                        continue;
-                    }
+                {
+                    AllocationProfiler::Scope zombiesScope(AllocationProfiler::Subsystem::ZOMBIES);
+                    zombiePool->Update(deltaTime, player, camera);
+                }
 
-                    // Let the zombie pool handle bullet collisions and death
-                    bool hitZombie = false;
-                    SDL_Rect bulletRect = bullet->GetHitbox();
-                    SDL_Point bulletPos = { static_cast<int>(bullet->GetX()), static_cast<int>(bullet->GetY()) };
-                    
-                    for (Zombie* zombie : zombiePool->GetActiveZombies()) {
-                        if (!zombie->IsDead() && zombie->CheckCollisionWithBullet(bullet)) {
-                            // Note: TakeDamage is now handled inside CheckCollisionWithBullet
-                            bullet->Deactivate();
-                            hitZombie = true;
-                            break;
-                        }
-                    }
-                    
-                    if (hitZombie) {
-                        bulletIt = bullets.erase(bulletIt);
-                        delete bullet;
-                    } else {
-                        ++bulletIt;
-                    }
+                // Check collision with player's bullets
+                if (collisionSystem && player) {
+                    AllocationProfiler::Scope collisionScope(AllocationProfiler::Subsystem::COLLISION);
+                    collisionSystem->ResolveBulletHits(player->GetProjectiles(), zombiePool, frameArena);
                 }
             }
               // Sync debug state between player and zombies
@@ -473,8 +520,25 @@ void Game::Update(float deltaTime) {    switch (currentState) {
                 }
             }
             
+            if (particleSystem) {
+                AllocationProfiler::Scope effectsScope(AllocationProfiler::Subsystem::EFFECTS);
+                particleSystem->Update(deltaTime);
+            }
+
+            if (lightMap && waveManager) {
+                AllocationProfiler::Scope effectsScope(AllocationProfiler::Subsystem::EFFECTS);
+                // Night waves dim the ambient light; the flashlight and muzzle flashes carry the scene
+                if (waveManager->IsNightWave()) {
+                    lightMap->SetAmbient({35, 35, 55, 255});
+                } else {
+                    lightMap->SetAmbient({255, 255, 255, 255});
+                }
+                lightMap->Update(deltaTime);
+            }
+
             if (chunkManager) { // Update ChunkManager
-                chunkManager->Update(deltaTime);
+                AllocationProfiler::Scope chunksScope(AllocationProfiler::Subsystem::CHUNKS);
+                chunkManager->Update(deltaTime, camera);
             }
             
             // Update camera to follow the player's center
@@ -483,6 +547,7 @@ void Game::Update(float deltaTime) {    switch (currentState) {
                 camera->Update(player->GetX(), player->GetY(), deltaTime);
             }
             break;
+        }
             
         case GameState::PAUSED:
             // In pause state, we don't update the game
@@ -497,16 +562,16 @@ void Game::Update(float deltaTime) {    switch (currentState) {
     }
 }
 
-SDL_Point Game::GetRandomSpawnPosition() const {
-    if (!player) return {0, 0};
-
-    static std::vector<SDL_Point> spawnPoints;
-    static int currentSpawnPoint = 0;
+SDL_Point Game::GetRandomSpawnPosition() {
+    if (!player || !simulation) return {0, 0};
+    Pcg32& random = simulation->GetRandom(RandomStream::SPAWNING);
 
     // Generate new spawn points if we're starting a new group
     if (spawnPoints.empty()) {
         float playerX = player->GetX();
         float playerY = player->GetY();
+        // Zoomed out, spawn as far out as the view reaches past the 1:1 view the distances were tuned for
+        float distanceScale = camera ? camera->GetDistanceScale() : 1.0f;
 
         // Create several spawn points around the player
         for (int i = 0; i < WaveConfig::SPAWN_POINTS; i++) {
@@ -514,8 +579,7 @@ SDL_Point Game::GetRandomSpawnPosition() const {
             float angle = (2.0f * M_PI * i) / WaveConfig::SPAWN_POINTS;
             
             // Get random distance between MIN and MAX spawn distance
-            float distance = MIN_SPAWN_DISTANCE + 
-                (static_cast<float>(rand()) / RAND_MAX * (MAX_SPAWN_DISTANCE - MIN_SPAWN_DISTANCE));
+            float distance = random.Range(MIN_SPAWN_DISTANCE, MAX_SPAWN_DISTANCE) * distanceScale;
             
             spawnPoints.push_back({
                 static_cast<int>(playerX + cos(angle) * distance),
@@ -526,8 +590,8 @@ SDL_Point Game::GetRandomSpawnPosition() const {
     SDL_Point basePoint = spawnPoints[currentSpawnPoint];
     
     // Get a random offset within the group spawn radius
-    float groupAngle = static_cast<float>(rand()) / RAND_MAX * 2 * M_PI;
-    float groupRadius = static_cast<float>(rand()) / RAND_MAX * WaveConfig::GROUP_SPAWN_RADIUS;
+    float groupAngle = random.NextFloat() * 2 * M_PI;
+    float groupRadius = random.NextFloat() * WaveConfig::GROUP_SPAWN_RADIUS;
     
     SDL_Point groupPos = {
         static_cast<int>(basePoint.x + cos(groupAngle) * groupRadius),
@@ -546,14 +610,14 @@ SDL_Point Game::GetRandomSpawnPosition() const {
 }
 
 void Game::SpawnZombie() {
-    if (!zombiePool || !waveManager) return;
+    if (!zombiePool || !waveManager || !simulation) return;
 
     SDL_Point spawnPos = GetRandomSpawnPosition();
-    Zombie* zombie = zombiePool->GetZombie();
+    Zombie* zombie = zombiePool->Resolve(zombiePool->GetZombie());
     if (zombie) {
         // Add random speed variation
         float speedMultiplier = 1.0f - WaveConfig::SPEED_VARIATION + 
-            (static_cast<float>(rand()) / RAND_MAX * (WaveConfig::SPEED_VARIATION * 2));
+            simulation->GetRandom(RandomStream::SPAWNING).NextFloat() * (WaveConfig::SPEED_VARIATION * 2);
             
         zombie->Reset(static_cast<float>(spawnPos.x), static_cast<float>(spawnPos.y), speedMultiplier);
         waveManager->OnZombieSpawned();
@@ -579,9 +643,11 @@ void Game::Render() {
             }
             break;
             
-        case GameState::PLAYING:
+        case GameState::PLAYING: {
+            AllocationProfiler::Scope renderScope(AllocationProfiler::Subsystem::RENDER);
             // Render the game world
             // Render tilemap first (background), adjusted by camera
+            BeginWorldPass();
             if (chunkManager) {
                 chunkManager->Render(camera);
             }
@@ -595,14 +661,29 @@ void Game::Render() {
             if (player) {
                 player->Render(renderer, camera);
             }
+            EndWorldPass();
+
+            RenderLighting();
+
+            // Effects go over the characters so muzzle flashes sit on the gun
+            BeginWorldPass();
+            if (particleSystem) {
+                particleSystem->Render(camera);
+            }
+            EndWorldPass();
             
             // Render UI with player's current health and ammo
             if (ui && player) {
                 ui->Render(player->GetHealth(), player->GetMaxHealth(), player->GetCurrentAmmo(), player->GetMaxAmmo());
             }
+            if (player && player->IsShowingDebugVisuals()) {
+                RenderDebugOverlay();
+            }
             break;
+        }
               case GameState::PAUSED:
             // First render the game world (frozen)
+            BeginWorldPass();
             if (chunkManager) {
                 chunkManager->Render(camera);
             }
@@ -614,6 +695,15 @@ void Game::Render() {
             if (player) {
                 player->Render(renderer, camera);
             }
+            EndWorldPass();
+
+            RenderLighting();
+
+            BeginWorldPass();
+            if (particleSystem) {
+                particleSystem->Render(camera);
+            }
+            EndWorldPass();
             
             if (ui && player) {
                 ui->Render(player->GetHealth(), player->GetMaxHealth(), player->GetCurrentAmmo(), player->GetMaxAmmo());
@@ -706,10 +796,45 @@ void Game::Render() {
     SDL_RenderPresent(renderer);
 }
 
+void Game::BeginWorldPass() {
+    // World objects draw in world pixels relative to the camera; the renderer scale applies the zoom
+    float zoom = camera ? camera->GetZoom() : 1.0f;
+    SDL_RenderSetScale(renderer, zoom, zoom);
+}
+
+void Game::EndWorldPass() {
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+}
+
+void Game::RenderLighting() {
+    if (!lightMap || !camera) return;
+
+    if (player) {
+        // Flashlight beam along the aim direction plus a faint glow so the player never vanishes
+        lightMap->AddLight({player->GetX(), player->GetY(), 480.0f, player->GetRotation(),
+                            {255, 240, 200, 255}, 0.9f, LightShape::CONE});
+        lightMap->AddLight({player->GetX(), player->GetY(), 110.0f, 0.0f,
+                            {200, 200, 220, 255}, 0.5f, LightShape::POINT});
+    }
+    lightMap->Render(camera);
+}
+
 void Game::Run() {
+    AllocationProfiler::SetMainThread();
     while (isRunning) {
         Uint32 currentTime = SDL_GetTicks();
         float deltaTime = (currentTime - previousTime) / 1000.0f;
+        // A scripted run advances exactly one fixed step per frame, however fast the host is
+        if (scriptedWaves > 0) {
+            deltaTime = FIXED_TIME_STEP;
+        }
+
+        // Nothing allocated from the arena survives a frame
+        if (frameArena) {
+            frameArena->Reset();
+        }
+        AllocationProfiler::BeginFrame();
+        CheckFrameAllocations();
         previousTime = currentTime;
 
         // Cap deltaTime to prevent physics issues after long pauses
@@ -717,6 +842,9 @@ void Game::Run() {
             deltaTime = 0.25f;
         }        // Process input
         HandleEvents();
+        if (scriptedWaves > 0) {
+            UpdateScriptedRun();
+        }
         
         // Handle state-specific updates
         switch (currentState) {
@@ -729,6 +857,9 @@ void Game::Run() {
                 // Update game with fixed time step
                 accumulator += deltaTime;
                 while (accumulator >= FIXED_TIME_STEP) {
+                    if (simulation) {
+                        simulation->Step(FIXED_TIME_STEP);
+                    }
                     Update(FIXED_TIME_STEP);
                     accumulator -= FIXED_TIME_STEP;
                 }
@@ -748,6 +879,7 @@ void Game::Run() {
 
         // Render the current state
         Render();        // Cap frame rate
+        if (scriptedWaves > 0) continue;
         int frameTime = SDL_GetTicks() - currentTime;
         if (frameTime < FRAME_TIME) {
             SDL_Delay(FRAME_TIME - frameTime);
@@ -777,6 +909,26 @@ void Game::Cleanup() {
         waveManager = nullptr;
     }
 
+    if (particleSystem) {
+        delete particleSystem;
+        particleSystem = nullptr;
+    }
+
+    if (lightMap) {
+        delete lightMap;
+        lightMap = nullptr;
+    }
+
+    if (collisionSystem) {
+        delete collisionSystem;
+        collisionSystem = nullptr;
+    }
+
+    if (simulation) {
+        delete simulation;
+        simulation = nullptr;
+    }
+
     if (player) {
         delete player;
         player = nullptr;
@@ -787,6 +939,11 @@ void Game::Cleanup() {
         ui = nullptr;
     }
 
+    if (flowField) {
+        delete flowField;
+        flowField = nullptr;
+    }
+
     if (chunkManager) { // Add ChunkManager cleanup
         delete chunkManager;
         chunkManager = nullptr;
@@ -797,6 +954,14 @@ void Game::Cleanup() {
         camera = nullptr;
     }
 
+    if (frameArena) {
+        delete frameArena;
+        frameArena = nullptr;
+    }
+
+    // Its font has to be closed before TTF_Quit below
+    loadingScreen.reset();
+
     if (renderer) {
         SDL_DestroyRenderer(renderer);
         renderer = nullptr;
@@ -819,6 +984,26 @@ void Game::CleanupGameState() {
         waveManager = nullptr;
     }
 
+    if (particleSystem) {
+        delete particleSystem;
+        particleSystem = nullptr;
+    }
+
+    if (lightMap) {
+        delete lightMap;
+        lightMap = nullptr;
+    }
+
+    if (collisionSystem) {
+        delete collisionSystem;
+        collisionSystem = nullptr;
+    }
+
+    if (simulation) {
+        delete simulation;
+        simulation = nullptr;
+    }
+
     if (player) {
         delete player;
         player = nullptr;
@@ -829,6 +1014,11 @@ void Game::CleanupGameState() {
         ui = nullptr;
     }
 
+    if (flowField) {
+        delete flowField;
+        flowField = nullptr;
+    }
+
     if (chunkManager) {
         delete chunkManager;
         chunkManager = nullptr;
@@ -843,4 +1033,147 @@ void Game::CleanupGameState() {
         delete zombiePool;
         zombiePool = nullptr;
     }
-}
\ No newline at end of file
+}
+
+void Game::CheckFrameAllocations() {
+    if (!checkAllocations || !AllocationProfiler::IsEnabled()) return;
+    if (currentState != GameState::PLAYING) {
+        steadyFrames = 0;
+        return;
+    }
+    if (++steadyFrames <= ALLOCATION_WARMUP_FRAMES) return;
+
+    // Background threads (chunk loading, flow field) are not part of the frame budget
+    AllocationProfiler::Counts total = AllocationProfiler::GetLastFrameTotal(false);
+    if (total.allocations == 0) return;
+
+    std::cerr << "Game: Steady-state frame " << steadyFrames << " made " << total.allocations
+              << " allocations (" << total.bytes << " bytes):";
+    for (int i = 0; i < static_cast<int>(AllocationProfiler::Subsystem::BACKGROUND); ++i) {
+        auto subsystem = static_cast<AllocationProfiler::Subsystem>(i);
+        AllocationProfiler::Counts counts = AllocationProfiler::GetLastFrame(subsystem);
+        if (counts.allocations > 0) {
+            std::cerr << " " << AllocationProfiler::GetName(subsystem) << "=" << counts.allocations;
+        }
+    }
+    std::cerr << std::endl;
+    allocationFailures++;
+    // A scripted run reports every failing frame and fails through its exit code instead
+    assert((scriptedWaves > 0 || total.allocations == 0) && "steady-state gameplay frame allocated");
+}
+
+void Game::SetScriptedRun(int waves) {
+    scriptedWaves = waves;
+    scriptedFrames = 0;
+    scriptedRunCompleted = false;
+    if (!hasFixedSeed) {
+        SetSeed(SCRIPTED_SEED);
+    }
+}
+
+int Game::GetExitCode() const {
+    if (scriptedWaves > 0 && !scriptedRunCompleted) return 1;
+    // Without the profiler every count reads zero, so a checked run would pass without checking
+    if (scriptedWaves > 0 && checkAllocations && !AllocationProfiler::IsEnabled()) return 1;
+    return allocationFailures > 0 ? 1 : 0;
+}
+
+void Game::UpdateScriptedRun() {
+    if (currentState == GameState::MAIN_MENU) {
+        currentState = GameState::LOADING;
+        InitializeGameState();
+        currentState = GameState::PLAYING;
+        return;
+    }
+    if (currentState == GameState::GAME_OVER) {
+        std::cerr << "Game: Scripted run: player died in wave " << waveManager->GetCurrentWave() << std::endl;
+        isRunning = false;
+        return;
+    }
+    if (currentState != GameState::PLAYING || !player || !zombiePool || !waveManager) return;
+
+    if (waveManager->GetCurrentWave() > scriptedWaves) {
+        std::cout << "Game: Scripted run finished " << scriptedWaves << " waves in " << scriptedFrames << " frames, "
+                  << allocationFailures << " steady-state frames allocated" << std::endl;
+        if (checkAllocations && !AllocationProfiler::IsEnabled()) {
+            std::cerr << "Game: --check-allocations needs a build with -DALLOCATION_PROFILER" << std::endl;
+        }
+        scriptedRunCompleted = true;
+        isRunning = false;
+        return;
+    }
+    if (++scriptedFrames > MAX_SCRIPTED_FRAMES) {
+        std::cerr << "Game: Scripted run stuck in wave " << waveManager->GetCurrentWave() << std::endl;
+        isRunning = false;
+        return;
+    }
+
+    // Aim at the nearest zombie and keep the trigger held; reload as soon as the magazine is empty
+    const Zombie* target = nullptr;
+    float bestDistanceSq = 0.0f;
+    for (const Zombie* zombie : zombiePool->GetActiveZombies()) {
+        if (zombie->IsDead()) continue;
+        float dx = zombie->GetX() - player->GetX();
+        float dy = zombie->GetY() - player->GetY();
+        float distanceSq = dx * dx + dy * dy;
+        if (!target || distanceSq < bestDistanceSq) {
+            target = zombie;
+            bestDistanceSq = distanceSq;
+        }
+    }
+    if (target) {
+        player->UpdateMousePosition(static_cast<int>(target->GetX()), static_cast<int>(target->GetY()));
+    }
+
+    SDL_Event event = {};
+    event.type = SDL_MOUSEBUTTONDOWN;
+    event.button.button = SDL_BUTTON_LEFT;
+    player->HandleInput(event);
+    if (player->GetCurrentAmmo() == 0) {
+        event = {};
+        event.type = SDL_KEYDOWN;
+        event.key.keysym.scancode = SDL_SCANCODE_R;
+        player->HandleInput(event);
+        event.type = SDL_KEYUP;
+        player->HandleInput(event);
+    }
+}
+
+void Game::RenderDebugOverlay() {
+    if (!ui || !frameArena) return;
+
+    const int x = 10;
+    int y = Constants::WINDOW_HEIGHT / 3;
+    if (zombiePool) {
+        y += ui->RenderDebugText(frameArena->Format("Zombie AI: %.0f us, %.0f / %.0f neighbor visits, steering 1/%d, %zu of %zu steered, %zu far groups",
+            zombiePool->GetAiMicroseconds(), zombiePool->GetAiWork(), ZombiePool::GetAiWorkBudget(), zombiePool->GetSteeringInterval(),
+            zombiePool->GetSteeredLastTick(), zombiePool->GetActiveCount(), zombiePool->GetFarGroupCount()), x, y);
+    }
+    if (collisionSystem) {
+        const CollisionSystem::Stats& collision = collisionSystem->GetStats();
+        y += ui->RenderDebugText(frameArena->Format("Collision: %zu bullets x %zu zombies, %zu tests, %.0f us",
+            collision.bullets, collision.zombies, collision.narrowTests, collision.microseconds), x, y);
+    }
+    if (chunkManager) {
+        ChunkManager::StreamingStats streaming = chunkManager->GetStreamingStats();
+        y += ui->RenderDebugText(frameArena->Format("Chunks: %zu not ready when visible (%zu now), %zu queued, %zu uploading%s",
+            streaming.notReadyEvents, streaming.notReadyVisible, streaming.queued, streaming.awaitingUpload,
+            streaming.prefetching ? ", prefetching" : ""), x, y);
+    }
+    if (!AllocationProfiler::IsEnabled()) {
+        ui->RenderDebugText("Allocations: build with -DALLOCATION_PROFILER", x, y);
+        return;
+    }
+
+    AllocationProfiler::Counts total = AllocationProfiler::GetLastFrameTotal(true);
+    y += ui->RenderDebugText(frameArena->Format("Allocations last frame: %llu (%llu bytes)",
+        static_cast<unsigned long long>(total.allocations), static_cast<unsigned long long>(total.bytes)), x, y);
+    for (int i = 0; i < static_cast<int>(AllocationProfiler::Subsystem::COUNT); ++i) {
+        auto subsystem = static_cast<AllocationProfiler::Subsystem>(i);
+        AllocationProfiler::Counts counts = AllocationProfiler::GetLastFrame(subsystem);
+        y += ui->RenderDebugText(frameArena->Format("  %-10s %6llu  %8llu B", AllocationProfiler::GetName(subsystem),
+            static_cast<unsigned long long>(counts.allocations), static_cast<unsigned long long>(counts.bytes)), x, y);
+    }
+    y += ui->RenderDebugText(frameArena->Format("Frame arena: %zu / %zu KB",
+        frameArena->GetLastFrameBytes() / 1024, frameArena->GetCapacity() / 1024), x, y);
+}
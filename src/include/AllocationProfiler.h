@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Opt-in heap allocation counter. Building with -DALLOCATION_PROFILER replaces the global
+// operator new/delete with versions that count every allocation and its size, attributed to
+// whichever Scope the allocating thread is in. Without the define the scopes compile to nothing
+// and every count reads zero.
+namespace AllocationProfiler {
+    enum class Subsystem {
+        GENERAL,      // Main thread outside any scope
+        PLAYER,       // Player update, including projectiles
+        WAVES,        // Wave manager and zombie spawning
+        ZOMBIES,      // Flow field and zombie pool
+        COLLISION,
+        EFFECTS,      // Particles and lighting
+        CHUNKS,
+        UI,
+        RENDER,
+        BACKGROUND,   // Any thread other than the main one
+        COUNT
+    };
+
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    bool IsEnabled();
+    // Call once on the main thread before the first frame; every other thread counts as BACKGROUND
+    void SetMainThread();
+    // Closes the current frame: its counts become the "last frame" ones and counting restarts
+    void BeginFrame();
+    Counts GetLastFrame(Subsystem subsystem);
+    Counts GetLastFrameTotal(bool includeBackground);
+    const char* GetName(Subsystem subsystem);
+
+#ifdef ALLOCATION_PROFILER
+    // Attributes this thread's allocations to a subsystem until it goes out of scope
+    class Scope {
+    public:
+        explicit Scope(Subsystem subsystem);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int previous;
+    };
+#else
+    class Scope {
+    public:
+        explicit Scope(Subsystem) {}
+    };
+#endif
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity lock-free queue, safe for any number of producer and consumer threads.
+// Every cell carries a sequence number that says whether it is ready to be written or read for the
+// current lap around the ring, so a push or pop is one compare-and-swap on the shared position.
+// Push fails instead of waiting when the queue is full.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t minimumCapacity)
+        : cells(RoundUpCapacity(minimumCapacity)), mask(cells.size() - 1), enqueuePosition(0), dequeuePosition(0) {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool Push(const T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;   // Full: this cell has not been read since the last lap
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& value) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;   // Empty
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t GetCapacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t RoundUpCapacity(size_t minimumCapacity) {
+        size_t capacity = 2;   // Power of two, so positions wrap with a mask
+        while (capacity < minimumCapacity) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    std::vector<Cell> cells;
+    size_t mask;
+    // Producers and consumers work on different lines
+    alignas(64) std::atomic<size_t> enqueuePosition;
+    alignas(64) std::atomic<size_t> dequeuePosition;
+};
@@ -26,11 +26,31 @@ public:
     int GetViewWidth() const { return viewWidth; }
     // Returns the camera's view height (screen height).
     int GetViewHeight() const { return viewHeight; }
+
+    // Returns how much of the world is visible, in world pixels (screen size divided by zoom).
+    float GetWorldViewWidth() const { return viewWidth / zoom; }
+    float GetWorldViewHeight() const { return viewHeight / zoom; }
+    // Half diagonal of the visible world, in world pixels
+    float GetWorldViewRadius() const;
+    // How many times farther the view reaches than the one gameplay distances (spawning,
+    // repositioning, recycling) were tuned for, never below 1. Those distances are multiplied
+    // by it, so zooming out or a bigger window does not show zombies appearing or vanishing.
+    float GetDistanceScale() const;
+
+    // Zoom factor: 1 is 1:1, below 1 zooms out. Clamped to [MIN_ZOOM, MAX_ZOOM].
+    // The camera keeps the point at the center of the screen fixed while zooming.
+    void SetZoom(float newZoom);
+    float GetZoom() const { return zoom; }
+
+    static constexpr float MIN_ZOOM = 0.25f;
+    static constexpr float MAX_ZOOM = 2.0f;
+    static constexpr float ZOOM_STEP = 1.1f; // Zoom multiplier per mouse wheel notch
+    static constexpr float REFERENCE_VIEW_RADIUS = 734.0f; // Half diagonal of a 1280x720 view at 1:1
     
     // Updates the camera's view dimensions (for window resize events)
     void SetViewDimensions(int width, int height);
 
-    // Converts world coordinates to screen coordinates.
+    // Converts world coordinates to screen coordinates (zoom applied).
     // Useful for rendering objects relative to the camera.
     SDL_FPoint WorldToScreen(float worldX, float worldY) const;
 
@@ -43,6 +63,7 @@ private:
     int viewWidth, viewHeight;  // Dimensions of the camera's viewport (usually screen size).
 
     float followSpeed;          // Speed at which the camera follows the target. Adjust for desired smoothness.
+    float zoom;                 // Screen pixels per world pixel.
 
     // Linear interpolation function for smooth movement.
     float lerp(float start, float end, float t) const;
@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+#include <map>
+#include <set>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include "BoundedQueue.h"
+
+class TileMap;
+
+// Define a simple struct or pair for chunk coordinates
+struct ChunkCoord {
+    int x, y;
+    // Comparison operator for using ChunkCoord as a map key
+    bool operator<(const ChunkCoord& other) const {
+        if (x < other.x) return true;
+        if (x > other.x) return false;
+        return y < other.y;
+    }
+};
+
+// Loads chunks on a fixed set of background threads.
+// Requests wait in a priority queue (lowest priority value first, then oldest) and can be
+// re-prioritized or cancelled until a worker picks them up. Finished chunks come back through a
+// lock-free queue, so collecting them never blocks the main thread on a worker. At most
+// `capacity` requests are in flight (queued, loading or waiting to be collected); past that
+// Request refuses and the caller asks again later.
+class ChunkLoader {
+public:
+    // Runs on a worker thread; returns null when the chunk could not be loaded
+    using LoadFunc = std::function<TileMap*(ChunkCoord coord)>;
+
+    struct Result {
+        ChunkCoord coord;
+        TileMap* chunk;     // Owned by whoever pops it; null if the load failed
+    };
+
+    explicit ChunkLoader(LoadFunc load, unsigned threadCount = DEFAULT_THREADS, size_t capacity = DEFAULT_CAPACITY);
+    ~ChunkLoader();
+    ChunkLoader(const ChunkLoader&) = delete;
+    ChunkLoader& operator=(const ChunkLoader&) = delete;
+
+    // Queues a load, or moves an already queued one to the new priority. True if the chunk is
+    // queued or already loading, false when the loader is full.
+    bool Request(ChunkCoord coord, float priority);
+    // Drops a queued load. False if it was not queued; a load already running still delivers.
+    bool Cancel(ChunkCoord coord);
+    // Main thread: takes one finished load, if any
+    bool PopResult(Result& result);
+
+    size_t GetQueuedCount() const;
+
+private:
+    static constexpr unsigned DEFAULT_THREADS = 2;
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    struct Job {
+        float priority;
+        uint64_t ticket;    // Request order; also tells a live heap entry from a superseded one
+        ChunkCoord coord;
+    };
+    // std::priority_queue keeps the largest on top, so "larger" means "load later"
+    struct LoadsLater {
+        bool operator()(const Job& a, const Job& b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.ticket > b.ticket;
+        }
+    };
+
+    LoadFunc load;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeCondition;
+    // Re-prioritizing or cancelling leaves the old heap entry behind; workers skip any entry whose
+    // ticket no longer matches queuedJobs, and the heap is rebuilt once stale entries pile up
+    std::priority_queue<Job, std::vector<Job>, LoadsLater> jobs;
+    std::map<ChunkCoord, Job> queuedJobs;
+    std::set<ChunkCoord> loadingNow;
+    uint64_t nextTicket;
+    bool stopping;
+
+    size_t capacity;
+    std::atomic<size_t> inFlight;   // Never above capacity, so results.Push always has room
+    BoundedQueue<Result> results;
+
+    void WorkerLoop();
+    void RebuildJobHeap();
+};
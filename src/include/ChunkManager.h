@@ -2,35 +2,42 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
-#include <thread> // Added
-#include <mutex>  // Added
-#include <future> // Added
 #include "TileMap.h"
 #include "Player.h"
 #include "Camera.h"
-
-// Define a simple struct or pair for chunk coordinates
-struct ChunkCoord {
-    int x, y;
-    // Comparison operator for using ChunkCoord as a map key
-    bool operator<(const ChunkCoord& other) const {
-        if (x < other.x) return true;
-        if (x > other.x) return false;
-        return y < other.y;
-    }
-    
-
-};
+#include "FrameArena.h"
+#include "ChunkLoader.h"
 
 class ChunkManager {
 public:
     ChunkManager(SDL_Renderer* renderer, Player* player, const std::string& baseMapPath, const std::string& baseTilesetPath);
     ~ChunkManager();
 
-    void Update(float deltaTime);
+    // The camera's world-space view decides how many chunks around the player stay loaded
+    void Update(float deltaTime, Camera* camera);
     void Render(Camera* camera);
 
+    // Walkability snapshot for pathfinding: fills blocked (cols x rows, row-major) with one entry
+    // per cellSize square starting at world (originX, originY), judged at the cell center.
+    // Read from the blueprint every chunk shares, so the result does not depend on which chunks
+    // the loader has finished: the same window gives the same cells on every run.
+    void FillBlockedCells(float originX, float originY, float cellSize, int cols, int rows,
+                          std::vector<Uint8>& blocked) const;
+    // Scratch lists built while updating the active set come from here (not owned, may be null)
+    void SetFrameArena(FrameArena* arena) { frameArena = arena; }
+
+    // For tuning prefetch: how often streaming fell behind what the camera shows
+    struct StreamingStats {
+        size_t notReadyEvents;    // Times a chunk came into view before it was active (once per chunk per miss)
+        size_t notReadyVisible;   // Chunks in view but not active on the last update
+        size_t queued;            // Waiting for a loader thread
+        size_t awaitingUpload;    // Decoded, waiting for their texture upload
+        bool prefetching;
+    };
+    StreamingStats GetStreamingStats() const;
+
 private:
     SDL_Renderer* renderer;
     Player* player;
@@ -40,21 +47,65 @@ private:
     TileMap* blueprintTileMap; // Used to get dimensions and as a blueprint
 
     std::map<ChunkCoord, TileMap*> activeChunks;
+    FrameArena* frameArena;
     ChunkCoord currentPlayerChunkCoord;
 
     int chunkWidthPixels;
     int chunkHeightPixels;
     
-    int viewDistanceChunks; // e.g., 1 means a 3x3 grid (player's chunk +/- 1)
+    int viewDistanceChunks; // e.g., 1 means a 3x3 grid (player's chunk +/- 1). Minimum; zooming out widens it.
+    int viewDistanceX;      // Current window half-size in chunks, grown to cover the zoomed-out view
+    int viewDistanceY;
+    int lastViewDistanceX;  // Window the active set was last built for
+    int lastViewDistanceY;
+
+    // Zoomed out, chunks are drawn from baked textures instead of tile by tile.
+    // Baking is spread over frames so crossing a LOD threshold does not hitch.
+    static constexpr int MAX_LOD_BAKES_PER_FRAME = 2;
 
     // --- Asynchronous Loading Members ---
-    std::map<ChunkCoord, std::future<void>> loadingTasks; // Tracks active loading operations
-    std::vector<std::pair<ChunkCoord, TileMap*>> readyToActivateChunks; // Chunks loaded by threads, awaiting activation
-    std::mutex readyChunksMutex; // Mutex to protect readyToActivateChunks
+    ChunkLoader* loader;                 // Background loads, nearest to the player first
+    std::set<ChunkCoord> pendingChunks;  // Requested from the loader and not collected yet
+    bool loadsRefused;                   // The loader was full; ask again next frame
+    // Loaded chunks whose tileset still has to become a texture. Uploads run on the main thread,
+    // nearest chunk first, until UPLOAD_BYTES_PER_FRAME is spent (always at least one per frame).
+    std::map<ChunkCoord, TileMap*> decodedChunks;
+    static constexpr size_t UPLOAD_BYTES_PER_FRAME = 16 * 1024 * 1024;
+
+    // Prefetch: the player's smoothed velocity projects a look-ahead point PREFETCH_SECONDS ahead.
+    // When that lands in another chunk, the window around it is loaded too, behind every chunk of
+    // the required window (PREFETCH_PRIORITY is added to the distance), and kept until the player
+    // turns away or arrives.
+    static constexpr float PREFETCH_SECONDS = 2.0f;
+    static constexpr float MIN_PREFETCH_SPEED = 50.0f;     // Pixels per second; slower counts as standing still
+    static constexpr float VELOCITY_SMOOTHING = 0.1f;      // Per update, so a single jerky step does not retarget
+    static constexpr float PREFETCH_PRIORITY = 1000.0f;
+    float lastPlayerX, lastPlayerY;
+    bool hasLastPlayerPosition;
+    float velocityX, velocityY;
+    bool prefetching;
+    ChunkCoord lookAheadChunkCoord;
+    bool lastPrefetching;                 // Prefetch state the active set was last built for
+    ChunkCoord lastLookAheadChunkCoord;
+
+    // "Not ready when visible" instrumentation
+    size_t notReadyEvents;
+    std::vector<ChunkCoord> notReadyCoords;   // Visible but missing on the last update, sorted
+    std::vector<ChunkCoord> notReadyScratch;
 
-    void LoadChunk(int chunkGridX, int chunkGridY); // Will be made async
+    TileMap* CreateChunk(ChunkCoord coord) const; // Runs on a loader thread
+    void LoadChunk(int chunkGridX, int chunkGridY); // Queues the chunk, or refreshes its priority if already queued
+    float GetLoadPriority(const ChunkCoord& coord) const;
     void UnloadChunk(int chunkGridX, int chunkGridY);
-    ChunkCoord GetChunkCoordFromWorldPos(float worldX, float worldY);
+    ChunkCoord GetChunkCoordFromWorldPos(float worldX, float worldY) const;
     void UpdateActiveChunks();
-    void ProcessReadyChunks(); // New method to move loaded chunks to activeChunks
+    void UpdateViewDistance(Camera* camera);
+    bool IsInWindow(const ChunkCoord& coord) const;
+    bool IsInPrefetchWindow(const ChunkCoord& coord) const;
+    bool IsWanted(const ChunkCoord& coord) const { return IsInWindow(coord) || IsInPrefetchWindow(coord); }
+    void UpdatePrefetch(float deltaTime);
+    void CountNotReadyVisible(Camera* camera);
+    static int SelectLodLevel(float zoom);
+    void ProcessReadyChunks(); // Collects finished loads into decodedChunks
+    void UploadDecodedChunks(); // Turns decoded chunks into active ones, within the frame's budget
 };
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include "SpatialGrid.h"
+#include "ProjectileSystem.h"
+#include "FrameArena.h"
+
+class Zombie;
+class ZombiePool;
+class ParticleSystem;
+class LightMap;
+
+// Bullet-versus-zombie hits. Once per tick the live zombies' hitbox centers go into a spatial grid.
+// Each bullet walks the cells along its last step (prev -> current position) and only tests the
+// zombies near them, so the pass costs O(B + Z) for a spread-out crowd instead of O(B * Z), and
+// the swept test catches hits at any speed instead of only where the bullet ended up.
+class CollisionSystem {
+public:
+    CollisionSystem();
+
+    // Damages the first zombie each bullet touches along its step, plays the impact effects at the
+    // point of contact and kills the bullet. Hits are killed after the lanes have been walked.
+    void ResolveBulletHits(ProjectileSystem* projectiles, ZombiePool* zombiePool, FrameArena* frameArena);
+
+    // Impact effects go here (not owned, may be null)
+    void SetParticleSystem(ParticleSystem* system) { particleSystem = system; }
+    void SetLightMap(LightMap* map) { lightMap = map; }
+
+    // Cost of the last pass, for the debug overlay
+    struct Stats {
+        size_t bullets;
+        size_t zombies;
+        size_t narrowTests;     // Bullet/zombie pairs the grid let through
+        float microseconds;
+    };
+    const Stats& GetStats() const { return stats; }
+
+private:
+    static constexpr float CELL_SIZE = 64.0f; // Zombie hitboxes are 50 px
+
+    ParticleSystem* particleSystem;
+    LightMap* lightMap;
+    Stats stats;
+
+    // Rebuilt every pass; grid index i is zombies[i]. Buffers are reused across ticks.
+    SpatialGrid zombieGrid;
+    std::vector<Zombie*> zombies;
+    std::vector<float> centerX, centerY;
+    float queryRadius;              // Bullet half size plus the larger hitbox half extent
+    std::vector<int> candidates;
+
+    void BuildZombieGrid(const ZombiePool* zombiePool);
+    // Earliest zombie along the segment, with the contact time as a fraction of it
+    Zombie* FindHit(float x0, float y0, float x1, float y1, float& hitTime);
+};
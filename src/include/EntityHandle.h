@@ -0,0 +1,16 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+// Reference to a pooled entity: its slot plus the generation the slot had when the handle was made.
+// A pool bumps the generation whenever it frees the slot, so a handle kept past its entity's
+// lifetime fails the pool's O(1) check instead of silently pointing at whatever reused the slot.
+// Tag only keeps handles from different pools apart.
+template <typename Tag>
+struct EntityHandle {
+    int index = -1;
+    Uint32 generation = 0;
+
+    bool IsNull() const { return index < 0; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
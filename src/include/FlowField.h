@@ -0,0 +1,76 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class ChunkManager; // Forward declaration
+
+// Shared path toward the player for the whole horde.
+// A Dijkstra pass from the player's cell over a square window of cells gives every cell the
+// direction to walk, so a zombie's pathfinding is one array lookup however many zombies there are.
+// The pass runs on a background thread whenever the player changes cell, and the finished field is
+// published exactly PUBLISH_LATENCY_TICKS Updates after it was requested, waiting for the worker
+// if it is late. Readers never see a half-built field, and which tick first sees a new one depends
+// only on the simulation, so replays stay exact. A new goal cell moves every cost, so each request
+// is a full rebuild: about 1 ms of one background thread for the 49x49 window, a few times a
+// second at most, well inside the latency.
+class FlowField {
+public:
+    FlowField();
+    ~FlowField();
+
+    // Main thread, once per fixed tick before the zombies update: publishes the build that is due
+    // and queues a new one if the player moved to another cell
+    void Update(float playerX, float playerY, const ChunkManager* chunks);
+
+    // Direction to walk from (x, y) to go around obstacles. Returns false when the field has
+    // nothing better than heading straight at the player: outside the window, unreachable,
+    // or with a clear line to the player's cell. Safe from any thread between Updates.
+    bool Sample(float x, float y, float& dirX, float& dirY) const;
+
+private:
+    static constexpr float CELL_SIZE = 64.0f;   // Two tiles per cell
+    static constexpr int RADIUS_CELLS = 24;     // Window reaches past ZombiePool's recycle distance
+    static constexpr int SIZE_CELLS = RADIUS_CELLS * 2 + 1;
+    static constexpr int STRAIGHT_COST = 10;
+    static constexpr int DIAGONAL_COST = 14;
+    static constexpr int UNREACHABLE = 0x7fffffff;
+    static constexpr unsigned PUBLISH_LATENCY_TICKS = 3;
+
+    struct Field {
+        int originCellX = 0, originCellY = 0;   // World cell of element (0, 0)
+        int goalCellX = 0, goalCellY = 0;       // Player's cell
+        std::vector<Uint8> blocked;
+        std::vector<int> cost;
+        std::vector<float> dirX, dirY;
+        std::vector<Uint8> lineOfSight;         // Cell can see the goal: steer straight instead
+        bool valid = false;
+    };
+
+    Field front;        // Read by Sample
+    Field back;         // Finished build, waiting for Update to publish it
+    Field request;      // Job handed to the worker
+    Field staging;      // Newest goal, filled by Update; waits here while another job is in flight
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;  // Update waits on this when a due build is not finished
+    bool requestPending;
+    bool backReady;
+    bool stopping;
+
+    // Main thread only: one job in flight at a time, so the publish tick of every field is fixed
+    unsigned tickCount;
+    unsigned publishTick;   // Tick on which the job in flight is published
+    bool jobInFlight;
+    bool stagingPending;
+    bool hasRequested;
+    int requestedCellX, requestedCellY;
+
+    void WorkerLoop();
+    static void Build(Field& field);
+    static bool HasLineOfSight(const Field& field, int fromX, int fromY);
+};
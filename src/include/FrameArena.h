@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdarg>
+#include <functional>
+#include <map>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Linear allocator for memory that only lives until the end of the frame.
+// Allocating bumps an offset into one block, and Reset() at the start of the next frame frees
+// everything at once. A request that does not fit falls back to the heap and is counted; the
+// next Reset grows the block to cover that frame's total, so after warm-up frames never reach the
+// heap. Main thread only, and nothing allocated from it may outlive the frame.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initialCapacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment);
+    // Only the latest allocation is actually given back; everything else waits for Reset
+    void Deallocate(void* pointer, size_t bytes);
+    void Reset();
+
+    // printf into arena memory. The text stays valid until the next Reset.
+    const char* Format(const char* format, ...);
+    const char* FormatV(const char* format, va_list args);
+
+    size_t GetCapacity() const { return capacity; }
+    size_t GetUsed() const { return offset; }
+    size_t GetLastFrameBytes() const { return lastFrameBytes; }  // Arena plus fallback bytes of the previous frame
+    size_t GetFallbackCount() const { return fallbackCount; }    // Heap fallbacks since startup
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    char* block;
+    size_t capacity;
+    size_t offset;
+    size_t fallbackBytes;     // Heap fallback bytes this frame
+    size_t lastFrameBytes;
+    size_t fallbackCount;
+    std::vector<void*> fallbacks;  // Heap blocks handed out this frame, freed by Reset
+
+    bool Owns(const void* pointer) const {
+        const char* bytes = static_cast<const char*>(pointer);
+        return bytes >= block && bytes < block + capacity;
+    }
+};
+
+// Standard allocator over a FrameArena, for containers that die before the frame ends.
+// Without an arena it behaves like std::allocator, so code can run before one is set.
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena* arena = nullptr) noexcept : arena(arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        if (!arena) return static_cast<T*>(::operator new(count * sizeof(T)));
+        return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (!arena) {
+            ::operator delete(pointer);
+            return;
+        }
+        arena->Deallocate(pointer, count * sizeof(T));
+    }
+
+    FrameArena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.arena != b.arena; }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using FrameMap = std::map<Key, Value, Compare, FrameAllocator<std::pair<const Key, Value>>>;
@@ -8,13 +8,20 @@
 #include "TileMap.h"
 #include "Camera.h"
 #include "ChunkManager.h"
+#include "FlowField.h"
+#include "Simulation.h"
 #include "Zombie.h"
 #include "ZombiePool.h"
 #include "WaveManager.h"
 #include "LoadingScreen.h"
+#include "ParticleSystem.h"
+#include "LightMap.h"
+#include "CollisionSystem.h"
 #include "GameState.h"
 #include "MainMenu.h"
 #include "Constants.h"
+#include "FrameArena.h"
+#include "AllocationProfiler.h"
 
 class Game {
 private:
@@ -47,12 +54,30 @@ private:
     Player* player;
     UI* ui;    Camera* camera; // Added camera member
     ChunkManager* chunkManager; // Added ChunkManager member
+    FlowField* flowField; // Shared zombie pathfinding around map obstacles
     ZombiePool* zombiePool; // Added ZombiePool member
-    std::vector<Zombie*> zombies; // Added zombies container
+    ParticleSystem* particleSystem; // Muzzle flash and impact effects
+    LightMap* lightMap; // Night lighting pass
+    CollisionSystem* collisionSystem; // Bullet hits, through a grid over the zombies
+    Simulation* simulation; // Fixed-step clock and seeded random streams for the current run
+    FrameArena* frameArena; // Scratch memory for the current frame, reset at the top of Run's loop
+    bool checkAllocations;  // Report (and assert on) gameplay frames that allocate, after warm-up
+    int steadyFrames;       // Frames in PLAYING since the check was armed
+    int allocationFailures; // Steady-state frames that allocated
+    int scriptedWaves;      // Scripted run: play through this many waves unattended, 0 for normal play
+    int scriptedFrames;
+    bool scriptedRunCompleted;
+    uint64_t fixedSeed; // Seed every run uses when hasFixedSeed (replays, benchmarks)
+    bool hasFixedSeed;
+    std::vector<SDL_Point> spawnPoints; // Spawn points of the group being spawned
+    int currentSpawnPoint;
     std::unique_ptr<LoadingScreen> loadingScreen; // Added LoadingScreen member
 
     // Game constants
     static constexpr int ZOMBIE_POOL_SIZE = 250; // Size of zombie pool
+    static constexpr int ALLOCATION_WARMUP_FRAMES = 600; // Pools and arenas settle before the check starts
+    static constexpr uint64_t SCRIPTED_SEED = 1;          // Scripted runs without --seed use this one
+    static constexpr int MAX_SCRIPTED_FRAMES = 60 * 60 * 10; // Ten simulated minutes, then the run counts as stuck
 
     // Wave constants
     static constexpr float INITIAL_SPAWN_DELAY = 2.0f; // Time between zombie spawns in seconds
@@ -73,13 +98,29 @@ public:
     void Render();
     void Run();
     void Cleanup();
+    // Makes every run use this seed instead of a time-based one, so it can be replayed
+    void SetSeed(uint64_t seed) { fixedSeed = seed; hasFixedSeed = true; }
+    // Needs a build with -DALLOCATION_PROFILER; otherwise there is nothing to check
+    void SetAllocationCheck(bool enabled) { checkAllocations = enabled; steadyFrames = 0; }
+    // Skips the menu and plays waves 1..waves with scripted input (aim at the nearest zombie,
+    // hold fire, reload when empty), one fixed step per frame and no frame cap, then quits.
+    // Same seed, same run: with the allocation check on it is the zero-allocation regression test.
+    void SetScriptedRun(int waves);
+    // Process exit code: nonzero when a scripted run did not finish its waves or a checked frame allocated
+    int GetExitCode() const;
 
 private:
     void SpawnZombie();
     void UpdateWaveState(float deltaTime);
-    SDL_Point GetRandomSpawnPosition() const;
+    SDL_Point GetRandomSpawnPosition();
     void InitializeGameState();  // Added declaration
     void CleanupGameState();     // Added declaration
     void UpdateWindowSize(int width, int height); // Method to update window dimensions
     void ToggleFullscreen(); // Method to toggle between fullscreen and windowed mode
+    void RenderLighting(); // Queue this frame's lights and multiply the light map over the world
+    void BeginWorldPass(); // Apply the camera zoom as renderer scale
+    void EndWorldPass();   // Back to 1:1 for screen-space passes (lighting, UI)
+    void CheckFrameAllocations();   // Runs after AllocationProfiler::BeginFrame
+    void UpdateScriptedRun();       // Scripted run: start, feed this frame's input, or stop
+    void RenderDebugOverlay();      // Collision cost, chunk streaming and last frame's allocations (debug visuals on)
 };
\ No newline at end of file
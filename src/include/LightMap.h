@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+class Camera; // Forward declaration
+
+enum class LightShape {
+    POINT,  // Radial falloff around (x, y)
+    CONE    // Flashlight beam starting at (x, y) pointing along angle
+};
+
+struct Light {
+    float x, y;          // World position
+    float radius;        // Reach in world pixels
+    float angle;         // Beam direction in degrees (CONE only)
+    SDL_Color color;
+    float intensity;     // 0..1, scales the color
+    LightShape shape;
+};
+
+// 2D lighting pass.
+// Lights are splatted with additive blending into a low-resolution render target that starts
+// at the ambient color, then the target is multiplied over the world layer.
+// The light count is capped, so the cost depends only on the screen size and MAX_LIGHTS,
+// never on how many zombies are on screen.
+class LightMap {
+public:
+    explicit LightMap(SDL_Renderer* renderer);
+    ~LightMap();
+
+    // Per-frame lights, cleared after every Render. Returns false once the cap is reached.
+    bool AddLight(const Light& light);
+    // Short-lived light that fades out on its own (muzzle flashes, impact sparks)
+    void AddFlash(float x, float y, float radius, SDL_Color color, float duration);
+
+    void Update(float deltaTime);
+    // Works in screen pixels, so call it with the renderer scale reset to 1
+    void Render(Camera* camera);
+
+    // Ambient fades toward the target so day/night changes are not a hard cut
+    void SetAmbient(SDL_Color target) { targetAmbient = target; }
+    bool IsDark() const;
+
+private:
+    static constexpr int MAX_LIGHTS = 48;          // Hard cap on lights splatted per frame
+    static constexpr int MAX_FLASHES = 32;         // Timed lights; the oldest is replaced when full
+    static constexpr int RESOLUTION_DIVISOR = 2;   // Half width x half height = a quarter of the pixels
+    static constexpr int SPRITE_SIZE = 128;
+    static constexpr float CONE_HALF_ANGLE = 28.0f; // Flashlight beam half-width in degrees
+    static constexpr float AMBIENT_FADE_SPEED = 60.0f; // Color units per second
+
+    struct Flash {
+        float x, y;
+        float radius;
+        SDL_Color color;
+        float timeLeft;
+        float duration;
+    };
+
+    SDL_Renderer* renderer;
+    SDL_Texture* lightTexture;   // Low-resolution accumulation target
+    SDL_Texture* pointSprite;
+    SDL_Texture* coneSprite;
+    int textureWidth, textureHeight;
+
+    float ambientR, ambientG, ambientB;
+    SDL_Color targetAmbient;
+
+    Light lights[MAX_LIGHTS];
+    int lightCount;
+    Flash flashes[MAX_FLASHES];
+    int flashCount;
+
+    bool EnsureTarget(int screenWidth, int screenHeight);
+    SDL_Texture* CreatePointSprite();
+    SDL_Texture* CreateConeSprite();
+    void DrawLight(const Light& light, const Camera* camera, int screenWidth, int screenHeight);
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <vector>
+#include <string>
+
+class Camera; // Forward declaration
+class Pcg32;  // Forward declaration
+
+// A single texture's worth of particles.
+// Particles are stored as a structure of arrays with a fixed capacity allocated up front,
+// so emitting never allocates and the update loop streams through plain float arrays.
+// All live particles are drawn with one SDL_RenderGeometry call.
+class ParticleEmitter {
+public:
+    ParticleEmitter(SDL_Renderer* renderer, const std::string& texturePath, size_t capacity, SDL_BlendMode blendMode);
+    ~ParticleEmitter();
+
+    // Emit count particles in a cone around angleDeg (degrees, same convention as Player::rotation)
+    void Emit(float x, float y, float angleDeg, float spreadDeg,
+              float minSpeed, float maxSpeed, float minLife, float maxLife,
+              float startSize, float endSize, SDL_Color color, int count);
+    void Update(float deltaTime);
+    void Render(Camera* camera);
+    void Clear() { count = 0; }
+
+    size_t GetCount() const { return count; }
+    size_t GetCapacity() const { return capacity; }
+    void SetDrag(float newDrag) { drag = newDrag; }
+    void SetRandom(Pcg32* stream) { random = stream; }
+
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    size_t capacity;
+    size_t count;     // Live particles occupy [0, count)
+    float drag;       // Fraction of velocity lost per second
+    Pcg32* random;    // Simulation stream for spread/speed/life jitter (may be null: no jitter)
+
+    // Particle state (structure of arrays)
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life;        // Remaining life in seconds
+    std::vector<float> invMaxLife;  // 1 / initial life, so the fade is a multiply
+    std::vector<float> startSize, endSize;
+    std::vector<Uint8> colorR, colorG, colorB;
+
+    // Batched draw buffers, sized for the full capacity at construction
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    void Kill(size_t index);
+};
+
+// Owns one emitter per effect texture and exposes the gameplay effects
+class ParticleSystem {
+public:
+    explicit ParticleSystem(SDL_Renderer* renderer);
+    ~ParticleSystem();
+
+    void EmitMuzzleFlash(float x, float y, float rotationDeg, int particleCount);
+    void EmitImpact(float x, float y, float bulletRotationDeg, bool isShotgunPellet);
+    void Update(float deltaTime);
+    void Render(Camera* camera);
+    void Clear();
+
+    size_t GetParticleCount() const;
+    // Particle jitter draws from this stream (owned by the Simulation)
+    void SetRandom(Pcg32* stream);
+
+private:
+    static constexpr size_t FLASH_CAPACITY = 8192;
+    static constexpr size_t IMPACT_CAPACITY = 8192;
+
+    ParticleEmitter* flashEmitter;   // Additive fire sprites for muzzle flashes and sparks
+    ParticleEmitter* impactEmitter;  // Alpha-blended splatter for zombie hits
+};
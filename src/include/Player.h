@@ -5,12 +5,16 @@
 #include <string>
 #include <vector>
 #include <map>
-#include "Bullet.h"  // Include Bullet header
+#include "ProjectileSystem.h"  // Player owns the projectiles it fires
 #include "Camera.h"  // Include Camera header
 #include "WeaponConfig.h"  // Include weapon configuration
 #include "WaveManager.h"  // Add WaveManager include
 #include "UI.h"  // Include UI header
 
+class ParticleSystem; // Forward declaration
+class LightMap;       // Forward declaration
+class Pcg32;          // Forward declaration
+
 enum class WeaponType {
     PISTOL,
     RIFLE,
@@ -96,12 +100,17 @@ private:    // Health constants
     std::map<WeaponType, std::vector<SDL_Texture*>> shootAnimations;
     std::map<WeaponType, std::vector<SDL_Texture*>> reloadAnimations;
 
-    // Collection of bullets
-    std::vector<Bullet*> bullets;
+    // Every projectile the player has fired, stored per bullet type
+    ProjectileSystem* projectiles;
 
     // WaveManager reference
     WaveManager* waveManager;
 
+    // Particle system for muzzle flashes (owned by Game, may be null)
+    ParticleSystem* particleSystem;
+    LightMap* lightMap;  // Muzzle lighting (owned by Game, may be null)
+    Pcg32* random;       // Shotgun spread stream (owned by the Simulation, may be null: no spread)
+
     // Helper functions for animation
     bool VerifyAnimationLoading(const std::string& weaponPath, WeaponType weapon);
     void PreloadAllWeaponAnimations(SDL_Renderer* renderer);
@@ -118,7 +127,7 @@ public:
     void Render(SDL_Renderer* renderer, Camera* camera);
     void UpdateMousePosition(int worldMouseX, int worldMouseY);
     void UpdateBullets(float deltaTime, Camera* camera);
-    std::vector<Bullet*>& GetBullets() { return bullets; }
+    ProjectileSystem* GetProjectiles() { return projectiles; }
 
     // Health methods
     int GetHealth() const { return currentHealth; }
@@ -139,6 +148,11 @@ public:
     
     // Wave manager methods
     void SetWaveManager(WaveManager* newWaveManager) { waveManager = newWaveManager; }
+
+    // Effects
+    void SetParticleSystem(ParticleSystem* newParticleSystem) { particleSystem = newParticleSystem; }
+    void SetLightMap(LightMap* newLightMap) { lightMap = newLightMap; }
+    void SetRandom(Pcg32* stream) { random = stream; }
     
     // Position methods
     float GetX() const { return x; }
@@ -0,0 +1,118 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <vector>
+#include "WeaponConfig.h"
+#include "EntityHandle.h"
+
+class Camera; // Forward declaration
+
+enum class BulletType {
+    PISTOL,
+    RIFLE,
+    SHOTGUN_PELLET,
+    COUNT
+};
+
+// Per-type constants. Each lane's update loop is instantiated for one type,
+// so speed and range are compile-time constants there instead of per-bullet fields.
+template <BulletType Type> struct BulletTraits;
+
+template <> struct BulletTraits<BulletType::PISTOL> {
+    static constexpr float SPEED = WeaponConfig::Pistol::BULLET_SPEED;
+    static constexpr float MAX_DISTANCE = 1000.0f;
+    static constexpr int DAMAGE = WeaponConfig::Pistol::DAMAGE;
+    static constexpr float KNOCKBACK_FORCE = 0.0f;
+    static constexpr float KNOCKBACK_DURATION = 0.0f;
+    static constexpr size_t CAPACITY = 128;
+};
+
+template <> struct BulletTraits<BulletType::RIFLE> {
+    static constexpr float SPEED = WeaponConfig::Rifle::BULLET_SPEED;
+    static constexpr float MAX_DISTANCE = 1000.0f;
+    static constexpr int DAMAGE = WeaponConfig::Rifle::DAMAGE;
+    static constexpr float KNOCKBACK_FORCE = 0.0f;
+    static constexpr float KNOCKBACK_DURATION = 0.0f;
+    static constexpr size_t CAPACITY = 256;
+};
+
+template <> struct BulletTraits<BulletType::SHOTGUN_PELLET> {
+    static constexpr float SPEED = WeaponConfig::Shotgun::BULLET_SPEED;
+    static constexpr float MAX_DISTANCE = 1000.0f;
+    static constexpr int DAMAGE = WeaponConfig::Shotgun::PELLET_DAMAGE;
+    static constexpr float KNOCKBACK_FORCE = WeaponConfig::Shotgun::KNOCKBACK_FORCE * WeaponConfig::Shotgun::KNOCKBACK_MULTIPLIER;
+    static constexpr float KNOCKBACK_DURATION = WeaponConfig::Shotgun::KNOCKBACK_DURATION;
+    static constexpr size_t CAPACITY = 1024;
+};
+
+// What a hit does to a zombie, for code that only knows the type at runtime
+struct BulletEffect {
+    int damage;
+    float knockbackForce;     // 0 when the type has no knockback
+    float knockbackDuration;
+};
+BulletEffect GetBulletEffect(BulletType type);
+
+// Every live projectile of one type, as a structure of arrays with a fixed capacity
+// allocated up front. Live projectiles occupy [0, count); Kill swap-removes, so the
+// arrays stay packed and firing never allocates. Swap-remove moves projectiles around,
+// so each one also has a stable id that maps back to its current index.
+struct ProjectileLane {
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;   // Position before the last step; hits are tested along prev -> current
+    std::vector<float> dirX, dirY;     // Unit direction; the type's SPEED scales it
+    std::vector<float> rotation;       // Degrees, for drawing and impact effects
+    std::vector<float> remaining;      // Distance left before the projectile expires
+    std::vector<int> id;               // Stable id of the projectile at each index
+    size_t count = 0;
+    size_t capacity = 0;
+
+    // Indexed by id
+    std::vector<int> indexOfId;        // Current index, -1 while the id is free
+    std::vector<Uint32> generationOfId;
+    std::vector<int> freeIds;
+
+    void Allocate(size_t newCapacity);
+    size_t Add();                      // Claims an index and an id; the caller fills in the fields
+    void Kill(size_t index);
+};
+
+using ProjectileHandle = EntityHandle<ProjectileLane>;
+
+// Owns the projectile lanes (one per BulletType) and the shared bullet texture
+class ProjectileSystem {
+public:
+    explicit ProjectileSystem(SDL_Renderer* renderer);
+    ~ProjectileSystem();
+
+    // angleDeg uses the same convention as Player::rotation. Returns a null handle when the type's lane is full.
+    ProjectileHandle Spawn(BulletType type, float x, float y, float angleDeg);
+    void Update(float deltaTime);
+    void Render(Camera* camera);
+    void Clear();
+
+    // Collision code reads a lane directly and kills hits by handle once it is done walking it
+    ProjectileLane& GetLane(BulletType type) { return lanes[static_cast<int>(type)]; }
+    const ProjectileLane& GetLane(BulletType type) const { return lanes[static_cast<int>(type)]; }
+    size_t GetCount() const;
+
+    // Handles stay valid while the projectile lives, wherever swap-removes move it
+    ProjectileHandle GetHandle(BulletType type, size_t index) const;
+    bool IsAlive(ProjectileHandle handle) const;
+    bool Kill(ProjectileHandle handle);     // False if the projectile was already gone
+
+    static SDL_Rect GetHitbox(float x, float y) {
+        return {static_cast<int>(x - BULLET_SIZE / 2), static_cast<int>(y - BULLET_SIZE / 2), BULLET_SIZE, BULLET_SIZE};
+    }
+
+    static constexpr int BULLET_SIZE = 8;   // Display and hitbox size
+
+private:
+    // A handle's index packs the lane into the bits above the id
+    static constexpr int LANE_SHIFT = 16;
+
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    SDL_Rect srcRect;
+    ProjectileLane lanes[static_cast<int>(BulletType::COUNT)];
+};
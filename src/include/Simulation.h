@@ -0,0 +1,54 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+// PCG32 (XSH-RR): 64-bit state, 32-bit output. Every (seed, stream) pair is an independent,
+// reproducible sequence, unlike the single global rand() state.
+class Pcg32 {
+public:
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0);
+
+    void Seed(uint64_t seed, uint64_t stream);
+    uint32_t Next();
+    float NextFloat();                               // [0, 1)
+    float Range(float minValue, float maxValue);     // [minValue, maxValue)
+    int RangeInt(int minValue, int maxValue);        // [minValue, maxValue], unbiased
+
+private:
+    uint64_t state;
+    uint64_t increment;     // Selects the stream; always odd
+};
+
+// One stream per subsystem, so extra draws in one (say, a new particle effect)
+// never shift the numbers another one sees
+enum class RandomStream {
+    SPAWNING,   // Wave spawn points and zombie speed variation
+    WAVES,      // Spawn group sizes
+    WEAPONS,    // Shotgun spread
+    ZOMBIES,    // Zombie repositioning
+    PARTICLES,  // Cosmetic effects
+    COUNT
+};
+
+// Deterministic state of one run: a clock that only moves by fixed simulation steps, and the
+// seeded random streams. The same seed and the same inputs replay a run exactly.
+class Simulation {
+public:
+    explicit Simulation(uint64_t seed);
+
+    void Reset(uint64_t newSeed);
+    // Called once per fixed update, before the update runs
+    void Step(float fixedStep);
+
+    Uint64 GetTick() const { return tick; }
+    // Use instead of SDL_GetTicks() anywhere inside the fixed-step update
+    Uint32 GetTimeMs() const { return static_cast<Uint32>(timeSeconds * 1000.0); }
+    uint64_t GetSeed() const { return seed; }
+    Pcg32& GetRandom(RandomStream stream) { return streams[static_cast<int>(stream)]; }
+
+private:
+    uint64_t seed;
+    Uint64 tick;
+    double timeSeconds;
+    Pcg32 streams[static_cast<int>(RandomStream::COUNT)];
+};
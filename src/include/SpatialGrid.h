@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// Uniform grid spatial hash for neighbor queries.
+// Points are bucketed by cell with a counting sort every Build, so a rebuild is two linear passes
+// and the buckets are stored contiguously. Queries visit only the cells overlapping the search
+// square, making a radius query O(k) in the number of nearby points instead of O(N).
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize, size_t bucketCount = DEFAULT_BUCKET_COUNT);
+
+    // Rebuild from scratch. Indices returned by queries refer to positions in these arrays.
+    void Build(const float* xs, const float* ys, size_t count);
+    // Sizes the per-point buffers for count points, so Build up to that many does not allocate
+    void Reserve(size_t count);
+
+    // Appends the index of every point that may lie within radius of (x, y).
+    // Candidates are not distance-filtered; callers still test the exact distance.
+    void Query(float x, float y, float radius, std::vector<int>& out) const;
+    // Appends every point that may lie within radius (per axis) of the segment (x0, y0)-(x1, y1).
+    // Walks the cells the segment crosses in order (DDA), so long segments cost cells crossed,
+    // not the area of their bounding box. Unfiltered like Query, and a path crossing many cells
+    // can report an index more than once.
+    void QuerySegment(float x0, float y0, float x1, float y1, float radius, std::vector<int>& out) const;
+
+    float GetCellSize() const { return cellSize; }
+    size_t GetCount() const { return cellOfPoint.size(); }
+
+private:
+    static constexpr size_t DEFAULT_BUCKET_COUNT = 4096; // Power of two, so the hash is a mask
+
+    float cellSize;
+    float inverseCellSize;
+    size_t bucketMask;
+
+    std::vector<int> bucketStart;   // bucketCount + 1 prefix sums into sortedIndices
+    std::vector<int> sortedIndices; // Point indices grouped by bucket
+    std::vector<int> cellOfPoint;   // Bucket of each point, kept between the two sort passes
+
+    // Two cells can hash to the same bucket; queries remember this many visited buckets so
+    // nobody is reported twice
+    static constexpr int MAX_TRACKED = 64;
+
+    int CellCoord(float value) const;
+    size_t Hash(int cellX, int cellY) const;
+    void AppendBlock(int minX, int minY, int maxX, int maxY,
+                     size_t* visited, int& visitedCount, std::vector<int>& out) const;
+};
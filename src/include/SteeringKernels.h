@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+struct SteeringWeights {
+    float player;      // Base force toward the player or formation slot
+    float separation;
+    float alignment;
+    float cohesion;
+};
+
+// Steering inputs and outputs for every zombie that steers this tick, one array per field,
+// so the combine/normalize/integrate step can run several zombies per instruction.
+// Lane i always belongs to the i-th zombie of the tick, so lanes can be filled from several threads.
+struct SteeringBatch {
+    std::vector<int> slot;                     // ZombieStore slot each lane belongs to, -1 for idle lanes
+    std::vector<float> baseX, baseY;           // Normalized direction to the player or formation target
+    std::vector<float> sepX, sepY, sepCount;   // Raw separation sum and contributor count
+    std::vector<float> aliX, aliY, aliCount;   // Raw alignment sum and count
+    std::vector<float> cohX, cohY, cohCount;   // Neighbor position sum and count
+    std::vector<float> posX, posY;             // In: current position. Out: integrated position
+    std::vector<float> speed;
+    size_t count = 0;
+
+    // Sizes the batch to exactly lanes lanes (contents are left for the caller to fill)
+    void Resize(size_t lanes);
+    // Sizes every lane array for lanes lanes, so Resize up to that many does not allocate
+    void Reserve(size_t lanes);
+    // Marks a lane as not steering: the kernels leave its position where it is
+    void SetIdle(size_t lane);
+};
+
+// Runtime-dispatched kernels for the batched part of the zombie steering.
+// Every kernel uses the same operation order as the scalar one; tests/steeringkernels_test checks
+// each SIMD kernel against the scalar one.
+namespace SteeringKernels {
+    using CombineFunc = void (*)(SteeringBatch& batch, size_t begin, size_t end,
+                                 float deltaTime, const SteeringWeights& weights);
+
+    // Averages and normalizes the flocking sums, mixes them with the base direction,
+    // normalizes the result and moves each lane by speed * deltaTime
+    void CombineScalar(SteeringBatch& batch, size_t begin, size_t end,
+                       float deltaTime, const SteeringWeights& weights);
+
+    // Kernel by name ("scalar", "SSE2" or "AVX2"), or null when this build or CPU lacks it
+    CombineFunc Find(const char* name);
+
+    // Best kernel this CPU supports (AVX2, SSE2 or scalar). Decided once, on first call.
+    CombineFunc Select();
+    const char* GetSelectedName();
+}
@@ -1,34 +1,78 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 class Camera; // Forward declaration
 
+// One layer of tile IDs, flat and row-major (row stride = width). Chunks loaded from the same
+// CSV share one of these; it is never written while shared (see TileMap::SetTile).
+struct TileLayer {
+    static constexpr uint16_t EMPTY = 0xFFFF; // Negative IDs in the CSV
+    int width = 0;
+    int height = 0;
+    std::vector<uint16_t> tiles;
+
+    uint16_t At(int column, int row) const { return tiles[static_cast<size_t>(row) * width + column]; }
+};
+
 class TileMap {
 private:
     SDL_Renderer* renderer;
     SDL_Texture* tileset;
-    std::vector<std::vector<int>> map;
+    SDL_Surface* decodedTileset;      // Decoded on a loader thread, waiting for UploadTileset
+    std::shared_ptr<TileLayer> map;   // Refcounted, shared between chunks until one of them writes
     int tileWidth;
     int tileHeight;
     int mapWidth;
     int mapHeight;
     int tilesetCols;
 
+    // Baked, pre-downsampled copies of the whole chunk. Level n is 1/2^n of full size.
+    // Level 0 is never baked: at full detail the tiles are drawn directly.
+    static constexpr int LOD_LEVELS = 4;
+    SDL_Texture* lodTextures[LOD_LEVELS];
+
 public:
     TileMap(SDL_Renderer* renderer);
     ~TileMap();
 
-    bool LoadTileset(const char* path);
+    bool LoadTileset(const char* path);   // DecodeTileset then UploadTileset; main thread only
+    // Two-stage load for background threads: decoding only touches CPU memory and is safe off the
+    // main thread; the upload creates the texture and must run on the main (render) thread.
+    bool DecodeTileset(const char* path);
+    bool UploadTileset();
+    bool NeedsUpload() const { return decodedTileset != nullptr; }
+    size_t GetUploadBytes() const { return decodedTileset ? static_cast<size_t>(decodedTileset->pitch) * decodedTileset->h : 0; }
     bool LoadMap(const char* path);
+    // Uses source's tiles without copying them. Safe from any thread as long as source is not being loaded.
+    void ShareMap(const TileMap& source);
+    // Copy-on-write: a chunk still sharing its tiles gets a private copy first. Pass a negative ID to clear.
+    void SetTile(int column, int row, int tileId);
+    int GetTile(int column, int row) const;
     void Render(Camera* camera, int worldOffsetX, int worldOffsetY);
+    // Draws the chunk as a single baked texture. Must be called on the main thread.
+    void RenderLod(Camera* camera, int worldOffsetX, int worldOffsetY, int level);
+    // Frees every baked level except keepLevel (pass -1 to free all)
+    void ReleaseLods(int keepLevel);
+
+    bool HasLod(int level) const { return level > 0 && level < LOD_LEVELS && lodTextures[level] != nullptr; }
+
+    static int GetLodLevelCount() { return LOD_LEVELS; }
 
     // Add these methods to get map dimensions in pixels
     int GetPixelWidth() const { return mapWidth * tileWidth; }
     int GetPixelHeight() const { return mapHeight * tileHeight; }
 
+    // Empty tiles (negative IDs) are holes: nothing is drawn there and nothing walks through them.
+    // localX/localY are pixels from the chunk's top-left corner.
+    bool IsBlockedAt(float localX, float localY) const;
+
 private:
     bool ParseCSV(const char* path);
+    SDL_Texture* GetLodTexture(int level);
+    SDL_Texture* BakeLod(int level);
 };
\ No newline at end of file
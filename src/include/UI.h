@@ -6,6 +6,7 @@
 #include <fstream>
 #include <algorithm>
 #include "Constants.h"
+#include "FrameArena.h"
 
 class UI {
 public:    // Score tracking structure - made public so it can be shared
@@ -18,10 +19,12 @@ private:    // Constants
     static constexpr int MARGIN_X = 20;
     static constexpr int MARGIN_Y = 50;  // Moved down from 20 to 50
     static constexpr int FONT_SIZE = 24;
+    static constexpr int DEBUG_FONT_SIZE = 16;
     static constexpr int BAR_WIDTH = 200;
     static constexpr int BAR_HEIGHT = 20;
     static constexpr int TEXT_SPACING = 5;
     static constexpr float NOTIFICATION_DURATION = 3.0f;  // How long notifications stay on screen
+    static constexpr size_t NOTIFICATION_RESERVE = 128;   // Longer messages still work, they just allocate
     static constexpr int WAVE_INFO_Y = 20;  // Wave info appears at top of screen
     // Removed hardcoded window dimensions as we'll use Constants namespace instead
 
@@ -38,6 +41,10 @@ private:    // Constants
     SDL_Rect healthRect;
     SDL_Texture* waveInfoTexture;
     SDL_Rect waveInfoRect;
+    // Text each cached texture was made from; a texture is only rebuilt when its text changes
+    std::string healthTextShown;
+    std::string ammoTextShown;
+    std::string waveInfoTextShown;
 
     // Notification system
     std::string notificationText;
@@ -46,6 +53,10 @@ private:    // Constants
     SDL_Rect notificationRect;
     std::vector<ScoreEntry> highScores;
 
+    // Per-frame text formatting goes here instead of stringstreams (not owned, may be null)
+    FrameArena* frameArena;
+    char formatFallback[256];   // Used when there is no arena
+
 public:
     UI(SDL_Renderer* renderer);
     ~UI();
@@ -53,12 +64,17 @@ public:
     void Cleanup();
     void Render(int currentHealth, int maxHealth, int currentAmmo, int maxAmmo);
     void ShowNotification(const std::string& text);
+    // Copies into a reserved buffer, so a literal message does not allocate mid-game
+    void ShowNotification(const char* text);
     void UpdateNotification(float deltaTime);
     void UpdateWaveInfo(int currentWave, int zombiesRemaining, float spawnTimer);
+    void SetFrameArena(FrameArena* arena) { frameArena = arena; }
     
     // Game state UI methods    
     void RenderPauseScreen();   
     void RenderGameOverScreen(int waveReached);
+    // Small one-off line of text for debug overlays, top-left at (x, y); returns its height
+    int RenderDebugText(const char* text, int x, int y);
     void SaveHighScore(int waveReached);
     
     // High score system management
@@ -74,5 +90,8 @@ private:
     void LoadHighScores();
     SDL_Texture* CreateTextTexture(const std::string& text);
     SDL_Texture* CreateTextTexture(const std::string& text, SDL_Color color, int fontSize = FONT_SIZE);
+    SDL_Texture* CreateTextTexture(const char* text, SDL_Color color, int fontSize = FONT_SIZE);
+    // printf-style; the result is valid until the next frame (or the next call without an arena)
+    const char* FormatText(const char* format, ...);
     std::string GetCurrentDateTimeString();
 };
@@ -45,4 +45,5 @@ namespace WaveConfig {
     static constexpr int BOSS_WAVE_INTERVAL = 5;         // Boss wave every X waves
     static constexpr float BOSS_HEALTH_MULTIPLIER = 5.0f;// Boss has 5x health
     static constexpr float BOSS_DAMAGE_MULTIPLIER = 2.0f;// Boss does 2x damage
+    static constexpr int NIGHT_WAVE_INTERVAL = 4;        // Every Xth wave is fought in the dark
 }
@@ -2,6 +2,8 @@
 #include "WaveConfig.h"
 #include <cstdint>
 
+class Pcg32; // Forward declaration
+
 class WaveManager {
 public:
     WaveManager();
@@ -19,6 +21,7 @@ public:
     float GetWaveDelay() const { return waitingForNextWave ? waveDelayTimer : 0.0f; }
     int GetCurrentGroupSize() const { return currentGroupSize; }
     bool IsBossWave() const { return currentWave % WaveConfig::BOSS_WAVE_INTERVAL == 0; }
+    bool IsNightWave() const { return currentWave > 0 && currentWave % WaveConfig::NIGHT_WAVE_INTERVAL == 0; }
     
     // Weapon unlocks
     bool IsRifleUnlocked() const { return currentWave >= WaveConfig::RIFLE_UNLOCK_WAVE; }
@@ -30,6 +33,8 @@ public:
     float GetHealthMultiplier() const;
     float GetSpeedMultiplier() const;    float GetDamageMultiplier() const;
     void OnZombieSpawned();
+    // Group sizes draw from this stream (owned by the Simulation). Set before StartNextWave.
+    void SetRandom(Pcg32* stream) { random = stream; }
     
 private:
     // Get random size for next zombie group
@@ -47,6 +52,7 @@ private:
     int zombiesInCurrentGroup;  // How many zombies spawned in current group
     int currentGroupSize;       // Total size of current group
     float lastTimerUpdate;      // For tracking spawn timer changes
+    Pcg32* random;              // May be null: groups are then always the minimum size
 
     void CalculateWaveParameters();
     void CheckWeaponUnlocks();
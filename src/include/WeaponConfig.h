@@ -8,6 +8,7 @@ namespace WeaponConfig {
         static constexpr float RELOAD_TIME = 1.0f;
         static constexpr int MAX_AMMO = 12;
         static constexpr float BULLET_SPEED = 800.0f;
+        static constexpr int MUZZLE_PARTICLES = 12;   // Sparks per muzzle flash
     }
 
     // Rifle configuration
@@ -17,6 +18,7 @@ namespace WeaponConfig {
         static constexpr float RELOAD_TIME = 1.0f;
         static constexpr int MAX_AMMO = 50;
         static constexpr float BULLET_SPEED = 1000.0f;
+        static constexpr int MUZZLE_PARTICLES = 16;
     }
 
     // Shotgun configuration
@@ -28,6 +30,7 @@ namespace WeaponConfig {
         static constexpr float RELOAD_TIME = 1.5f;
         static constexpr int MAX_AMMO = 8;
         static constexpr float BULLET_SPEED = 600.0f;
+        static constexpr int MUZZLE_PARTICLES = 60;   // Wide blast for the whole pellet spread
         
         // Knockback configuration
         static constexpr float KNOCKBACK_FORCE = 400.0f;
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <type_traits>
+
+// Fixed set of worker threads for data-parallel loops.
+// ParallelFor splits [0, count) into grain-sized chunks that the workers and the calling thread
+// pull from a shared counter, and returns once every chunk is done. Chunks must be independent:
+// which thread runs a chunk is not deterministic, so results must not depend on it.
+class WorkerPool {
+public:
+    // threadCount = 0 uses every hardware thread (the caller counts as one)
+    explicit WorkerPool(unsigned threadCount = 0);
+    ~WorkerPool();
+
+    // func(begin, end, worker): worker is in [0, GetThreadCount()), stable for the whole chunk,
+    // so it can index per-thread scratch space. func is called through a plain function pointer
+    // and a pointer to it, never copied, so a lambda capturing any amount costs no allocation.
+    template <typename Func>
+    void ParallelFor(size_t count, size_t grain, Func&& func) {
+        using Body = std::remove_reference_t<Func>;
+        Run(count, grain, [](const void* context, size_t begin, size_t end, unsigned worker) {
+            (*static_cast<Body*>(const_cast<void*>(context)))(begin, end, worker);
+        }, &func);
+    }
+
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+private:
+    using RangeThunk = void (*)(const void* context, size_t begin, size_t end, unsigned worker);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    // Current job, published under mutex
+    RangeThunk job;
+    const void* jobContext;
+    size_t jobCount;
+    size_t jobGrain;
+    std::atomic<size_t> nextChunk;
+    unsigned generation;    // Bumped for every job so sleeping workers know there is new work
+    unsigned busyWorkers;
+    bool stopping;
+
+    void Run(size_t count, size_t grain, RangeThunk thunk, const void* context);
+    void WorkerLoop(unsigned worker);
+    void RunChunks(unsigned worker);
+};
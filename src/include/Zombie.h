@@ -2,49 +2,107 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include "Player.h"
-#include "Bullet.h"
+#include "ProjectileSystem.h"
 #include "Camera.h"
 #include "WeaponConfig.h"
+#include "SteeringKernels.h"
+#include "FlowField.h"
+#include "EntityHandle.h"
 #include <vector>
 #include <string>
+#include <cmath>
 
 // Enable hitbox visualization
 #define DEBUG_HITBOX
 
+// Sprites and sizes shared by every zombie. Loaded once by ZombiePool instead of once per zombie.
+struct ZombieAssets {
+    static const int MOVE_FRAME_COUNT = 17;  // Number of frames in move animation
+    static const int ATTACK_FRAME_COUNT = 9;  // Number of frames in attack animation
+
+    std::vector<SDL_Texture*> moveFrames;
+    std::vector<SDL_Texture*> attackFrames;
+    SDL_Rect srcRect = {0, 0, 0, 0};
+    int destWidth = 0;
+    int destHeight = 0;
+    int hitboxWidth = 50;   // width of zombie
+    int hitboxHeight = 50;  // height of zombie
+
+    void Load(SDL_Renderer* renderer);
+    void Free();
+};
+
+// Per-zombie state as a structure of arrays, indexed by slot and owned by ZombiePool.
+// The fields the steering and collision loops read every tick sit in their own tightly packed arrays.
+struct ZombieStore {
+    // Hot: read for every neighbor in the steering pass
+    std::vector<float> x, y;
+    std::vector<int> hitboxX, hitboxY;  // Top-left of the hitbox, kept in sync with x/y
+    std::vector<Uint8> dead;
+
+    // Movement and combat
+    std::vector<float> speed;
+    std::vector<float> rotation;        // Angle in degrees
+    std::vector<float> knockbackVelocityX, knockbackVelocityY, knockbackDuration;
+    std::vector<float> velocityX, velocityY;  // Last steered velocity, reused while a zombie coasts
+    std::vector<int> health;
+    std::vector<Uint8> attacking;
+    std::vector<Uint32> lastAttackTime;
+
+    // Animation
+    std::vector<int> currentFrame;
+    std::vector<float> frameTimer;
+
+    // Bumped by ZombiePool each time the slot is freed; see ZombieHandle
+    std::vector<Uint32> generation;
+
+    // Previous-tick copy of the fields other zombies read. During a parallel tick every zombie
+    // reads neighbors from here and writes only its own slot in the arrays above.
+    std::vector<float> prevX, prevY;
+    std::vector<int> prevHitboxX, prevHitboxY;
+    std::vector<Uint8> prevDead;
+
+    bool showDebugHitbox = false;       // Debug drawing is a pool-wide switch
+
+    void Reserve(size_t capacity);
+    void SnapshotPrevious();            // Copy the live neighbor fields into the prev* buffers
+    size_t Size() const { return x.size(); }
+};
+
+// Angular occupancy of the ring around the player, built once per tick by ZombiePool.
+// Zombies in the formation band read it in O(1) to find the emptiest nearby part of the ring.
+struct FormationStats {
+    static constexpr int SLOT_COUNT = 24;  // 15 degrees per slot
+    float playerX = 0, playerY = 0;
+    int occupancy[SLOT_COUNT] = {};         // Zombies within formation range, per angular slot
+
+    // angle is in radians around the player, as returned by atan2
+    static int SlotOf(float angle) {
+        int index = static_cast<int>((angle + M_PI) / (2 * M_PI) * SLOT_COUNT);
+        return ((index % SLOT_COUNT) + SLOT_COUNT) % SLOT_COUNT;
+    }
+    static float SlotAngle(int index) {
+        return static_cast<float>((index + 0.5f) * (2 * M_PI) / SLOT_COUNT - M_PI);
+    }
+};
+
+class Zombie;
+using ZombieHandle = EntityHandle<Zombie>;
+
+// Lightweight view of one zombie slot in a ZombieStore.
+// Handles are stable for the lifetime of the pool; all state lives in the store.
 class Zombie {
 private:
-    SDL_Rect hitbox;
-    float x, y;    float rotation;  // Angle in degrees
-    int health;
-    bool isDead;
-    float speed;
-    bool isAttacking;
-    Uint32 lastAttackTime;
+    ZombieStore* store;
+    const ZombieAssets* assets;
+    int slot;
+
     const Uint32 ATTACK_COOLDOWN = 1000; // 1 second cooldown between attacks    // Damage and health constants
     static constexpr int STARTING_HEALTH = 8;      // Zombie starting health
-    
-    // Debug visualization
-    bool showDebugHitbox;
-
-    // Knockback properties
-    float knockbackVelocityX;
-    float knockbackVelocityY;
-    float knockbackDuration;
-
-    // Animation members
-    SDL_Renderer* renderer;
-    std::vector<SDL_Texture*> moveFrames;
-    std::vector<SDL_Texture*> attackFrames;
-    int currentFrame;
-    float frameTimer;
-    float frameDuration;
-    SDL_Rect srcRect;
-    SDL_Rect destRect;
 
     // Animation constants
-    static const int MOVE_FRAME_COUNT = 17;  // Number of frames in move animation
-    static const int ATTACK_FRAME_COUNT = 9;  // Number of frames in attack animation
     static constexpr float DEFAULT_FRAME_DURATION = 0.1f;  // Duration per frame in seconds
+    static constexpr float HEALTH_BAR_MIN_ZOOM = 0.5f;     // Health bars are unreadable (and cost two draws) below this zoom
 
     // Flocking behavior constants
     static constexpr float NEIGHBOR_RADIUS = 90.0f;
@@ -57,37 +115,84 @@ private:
     static constexpr float FORMATION_RANGE = 450.0f;  // Increased from 400
     static constexpr float FORMATION_RADIUS = 300.0f;
     static constexpr float FORMATION_WEIGHT = 0.8f;
+    static constexpr int FORMATION_SEARCH_SLOTS = 4;  // How far around the ring a zombie looks for a gap
 
     // Collision constants
-   
+
 
 public:
-    Zombie(SDL_Renderer* renderer, float startX, float startY);
-    ~Zombie();
+    // Flocking only looks this far; ZombiePool's spatial grid uses it as cell size and query radius.
+    // The small margin keeps points sitting exactly on the radius inside the queried cells.
+    static constexpr float NEIGHBOR_QUERY_RADIUS =
+        (MIN_SEPARATION > NEIGHBOR_RADIUS ? MIN_SEPARATION : NEIGHBOR_RADIUS) + 4.0f;
+
+    // Appends a new slot to the store and becomes its handle
+    Zombie(ZombieStore* store, const ZombieAssets* assets, float startX, float startY);
+
+    // Counts the live zombies in slots (read from the prev* buffers) into stats by angle around the player
+    static void BuildFormationStats(const ZombieStore& store, const std::vector<int>& slots,
+                                    float playerX, float playerY, FormationStats& stats);
 
-    void Update(float deltaTime, Player* player, const std::vector<Zombie*>& zombies);
+    static constexpr SteeringWeights STEERING_WEIGHTS = {
+        PLAYER_ATTRACTION_WEIGHT, SEPARATION_WEIGHT, ALIGNMENT_WEIGHT, COHESION_WEIGHT
+    };
+
+    // A tick is split in three so the arithmetic in the middle can run batched. Phases 1 and 3 only
+    // write this zombie's own slot and read other zombies from the store's prev* buffers, so
+    // different zombies can run on different threads.
+    // 1. PrepareSteering: knockback, facing, base direction and neighbor sums. Returns false when
+    //    the zombie does not steer this tick; otherwise fills batch lane `lane`.
+    //    formation: this tick's ring occupancy. neighbors: the zombies near this one (flocking).
+    //    flowField: shared path to the player around obstacles, may be null.
+    // 2. The caller runs a SteeringKernels combine over the batch and writes positions back.
+    // 3. FinishUpdate: player contact, attack timing and animation. Returns true when the zombie
+    //    lands a hit; the caller applies the damage to the player afterwards, in a fixed order.
+    //    currentTime is the simulation clock in milliseconds (Simulation::GetTimeMs).
+    bool PrepareSteering(float deltaTime, Player* player, const FormationStats& formation,
+                         const FlowField* flowField, const std::vector<int>& neighbors,
+                         SteeringBatch& batch, size_t lane);
+    bool FinishUpdate(float deltaTime, Player* player, Uint32 currentTime);
+    // Cheap tick for zombies nobody can see: keep moving at the stored velocity, no steering or animation
+    void Coast(float deltaTime);
+    // Moves the zombie without any other update (collision resolution)
+    void MoveTo(float newX, float newY);
     void Render(SDL_Renderer* renderer, Camera* camera);
-    bool CheckCollisionWithBullet(Bullet* bullet);
+    // Swept test for a bullet moving from (x0, y0) to (x1, y1): true if its hitbox (halfSize from its
+    // center) touches this zombie's on the way, with hitTime the fraction of the step where contact begins.
+    // Does not apply the hit; see TakeDamage.
+    bool IntersectBulletPath(float x0, float y0, float x1, float y1, float halfSize, float& hitTime) const;
     bool CheckCollisionWithPlayer(Player* player);
-    bool IsDead() const { return isDead; }
-    SDL_Rect GetHitbox() const { return hitbox; }
-    float GetX() const { return x; }
-    float GetY() const { return y; }
-    float GetRotation() const { return rotation; }    void Reset(float newX, float newY, float speedMultiplier = 1.0f);    // Reset zombie position and stats
-    void TakeDamage(float damageX, float damageY, bool isShotgunPellet, Bullet* bullet);
-    
+    bool IsDead() const { return store->dead[slot] != 0; }
+    SDL_Rect GetHitbox() const { return {store->hitboxX[slot], store->hitboxY[slot], assets->hitboxWidth, assets->hitboxHeight}; }
+    float GetX() const { return store->x[slot]; }
+    float GetY() const { return store->y[slot]; }
+    float GetRotation() const { return store->rotation[slot]; }
+    int GetSlot() const { return slot; }
+    void Reset(float newX, float newY, float speedMultiplier = 1.0f);    // Reset zombie position and stats
+    void TakeDamage(float damageX, float damageY, BulletType type);
+
     // Debug visualization methods
-    void SetDebugHitbox(bool show) { showDebugHitbox = show; }
-    bool IsShowingDebugHitbox() const { return showDebugHitbox; }
+    void SetDebugHitbox(bool show) { store->showDebugHitbox = show; }
+    bool IsShowingDebugHitbox() const { return store->showDebugHitbox; }
 
 private:
-    void ApplyFlockingBehavior(const std::vector<Zombie*>& zombies, float& dx, float& dy);
-    void Separate(const std::vector<Zombie*>& zombies, float& dx, float& dy);
-    void Align(const std::vector<Zombie*>& zombies, float& dx, float& dy);
-    void Cohere(const std::vector<Zombie*>& zombies, float& dx, float& dy);
-    
+    // Raw sums gathered by the single steering pass; the combine kernel turns them into forces
+    struct SteeringSums {
+        float sepX = 0, sepY = 0;
+        int sepCount = 0;
+        float aliX = 0, aliY = 0;
+        int aliCount = 0;
+        float cohX = 0, cohY = 0;
+        int cohCount = 0;
+    };
+
+    // Visits each neighbor once and accumulates separation, alignment and cohesion together,
+    // testing squared distances
+    void AccumulateSteering(const std::vector<int>& neighbors, SteeringSums& sums) const;
+    // Ring angle to head for: the least crowded slot within FORMATION_SEARCH_SLOTS of this zombie
+    float ChooseFormationAngle(const FormationStats& formation, float angleAroundPlayer) const;
+
     // Animation methods
-    void LoadTextures();
-    void LoadAnimationSet(std::vector<SDL_Texture*>& frames, const std::string& basePath, const std::string& prefix, int frameCount);
     void UpdateAnimation(float deltaTime);
+    void SyncHitbox();
 };
@@ -1,43 +1,211 @@
 #pragma once
 #include <vector>
-#include <queue>
 #include "Zombie.h"
 #include "Player.h"
 #include "Camera.h"
+#include "SpatialGrid.h"
+#include "WorkerPool.h"
+#include "Simulation.h"
 
 class ZombiePool {
 public:
     explicit ZombiePool(SDL_Renderer* renderer, size_t poolSize);
     ~ZombiePool();
 
-    Zombie* GetZombie();
-    void ReturnZombie(Zombie* zombie);
-    void Update(float deltaTime, Player* player);
+    // Zombies are referred to by generational handles; keep the handle, not the pointer, across
+    // ticks. Resolve is O(1) and returns null once the zombie has been returned to the pool.
+    ZombieHandle GetZombie();
+    void ReturnZombie(ZombieHandle handle);
+    Zombie* Resolve(ZombieHandle handle) const;
+    bool IsValid(ZombieHandle handle) const { return Resolve(handle) != nullptr; }
+    ZombieHandle GetHandle(const Zombie* zombie) const;
+    // camera sizes the full-detail tier to what is on screen; without one a default radius is used
+    void Update(float deltaTime, Player* player, const Camera* camera = nullptr);
     void Render(SDL_Renderer* renderer, Camera* camera);
+    // Pointers here are only good until the next Update or ReturnZombie
     const std::vector<Zombie*>& GetActiveZombies() const { return activeZombies; }
     size_t GetActiveCount() const { return activeZombies.size(); }
+    size_t GetFarGroupCount() const { return farGroups.size() - freeGroups.size(); }
+
+    struct Stats {
+        size_t capacity;        // Zombies allocated, in use or free
+        size_t active;
+        size_t highWaterMark;   // Most zombies ever active at once
+        size_t growths;         // Times the pool had to grow past its previous capacity
+    };
+    Stats GetStats() const { return {pool.size(), activeZombies.size(), highWaterMark, growthCount}; }
 
     // New methods for enhanced pooling    
     void RecycleDistantZombies(Player* player, float maxDistance);
     void OptimizeZombieDistribution(Player* player);
-    void PrewarmPool();
-    void AddZombie();  // New method for incremental creation
+    void AddZombie();  // Adds one free zombie; GetZombie also grows the pool on its own when empty
     
     // Debug visualization methods
     void SetDebugHitboxForAll(bool show);
 
+    // Zombie AI per tick (smoothed): wall-clock time for display, and the neighbor visits the
+    // steering rate adapts to against their budget
+    float GetAiMicroseconds() const { return aiMicroseconds; }
+    float GetAiWork() const { return aiWork; }
+    static constexpr float GetAiWorkBudget() { return AI_WORK_BUDGET; }
+    int GetSteeringInterval() const { return steeringInterval; }
+    size_t GetSteeredLastTick() const { return steeredLastTick; }
+
+    // Zombies chasing from outside formation range follow this around obstacles (not owned)
+    void SetFlowField(const FlowField* field) { flowField = field; }
+    // Attack cooldowns run on this clock and repositioning draws from its ZOMBIES stream (not owned)
+    void SetSimulation(Simulation* newSimulation) { simulation = newSimulation; }
+
 private:
     static constexpr float RECYCLE_DISTANCE = 1200.0f;  // Distance at which zombies get recycled
     static constexpr float OPTIMAL_DISTANCE = 800.0f;   // Optimal distance to maintain zombies
+    static constexpr float REPOSITION_SPREAD = 0.4f;    // Repositioned zombies land up to this much past OPTIMAL_DISTANCE
     static constexpr float MIN_RECYCLE_DISTANCE = 600.0f; // Minimum distance for recycling during high load
+    static constexpr size_t MIN_GROWTH = 16;              // Smallest batch of zombies added when the pool runs dry
+    static constexpr size_t MAX_CAPACITY = 4096;          // Growth stops here
     
     SDL_Renderer* renderer;
-    std::vector<Zombie*> pool;
+    ZombieAssets assets;        // Textures shared by every zombie
+    ZombieStore store;          // All zombie state, one slot per pooled zombie
+    std::vector<Zombie*> pool;  // Handle for each slot, pool[i]->GetSlot() == i
+
+    // Free list plus packed active list. Releasing swaps the last active zombie into the hole,
+    // so acquire, release and iteration are O(1) per zombie and never search.
     std::vector<Zombie*> activeZombies;
-    std::vector<bool> isInUse;
-    std::queue<Zombie*> recycledZombies;  // Queue for quick access to recycled zombies
+    std::vector<int> activeSlots;   // activeSlots[i] == activeZombies[i]->GetSlot(); the tick's lane order
+    std::vector<int> activeIndex;   // Position of each slot in activeZombies, -1 while free
+    std::vector<int> freeSlots;     // Stack of unused slots, most recently released on top
+    size_t highWaterMark;
+    size_t growthCount;
+    std::vector<int> recycleScratch;  // Slots to release, reused by the recycling passes
+
+    // Neighbor lookup for flocking, rebuilt once per Update. Scratch buffers are reused across ticks.
+    SpatialGrid neighborGrid;
+    std::vector<float> gridX, gridY;
+    std::vector<int> updatedSlots;    // Slots that were alive when this tick started
+    FormationStats formationStats;    // Ring occupancy around the player, rebuilt once per tick
+    const FlowField* flowField;
+    Simulation* simulation;
+    float optimizeTimer;
+
+    // Per-thread buffers for neighbor queries
+    struct WorkerScratch {
+        std::vector<int> query;
+        std::vector<int> neighbors;   // Slots near the zombie being updated
+        size_t neighborVisits = 0;    // Added up by GatherNeighbors this tick
+    };
+    std::vector<WorkerScratch> workerScratch;
+
+    // Batched steering: filled by Zombie::PrepareSteering, consumed by the selected SIMD kernel
+    SteeringBatch steeringBatch;
+    SteeringKernels::CombineFunc combineSteering;
+
+    // The tick is split across these threads. Lane i of every per-tick buffer belongs to
+    // activeSlots[i], and player damage is applied afterwards in lane order, so the outcome
+    // does not depend on the thread count.
+    WorkerPool* workers;
+    std::vector<Uint8> landedHits;
+    static constexpr size_t ZOMBIES_PER_TASK = 32;
     
+    // Simulation tiers by distance to the player. Zombies on screen (plus a margin) steer every
+    // tick. The ring just beyond steers one tick in MID_STEER_INTERVAL and coasts in between.
+    // Further out, zombies merge into far groups: one agent per GROUP_CELL_SIZE cell with a
+    // centroid, member count and mean speed. A group steers and moves once per tick; members keep
+    // only their anchor (position relative to where the group formed), so their position is the
+    // anchor plus the group's offset. A group splits back into individuals, coasting on its
+    // velocity, as soon as any member comes inside the group radius.
+    enum class LaneAction : Uint8 {
+        IDLE,       // Dead: nothing to do
+        STEER,      // Recompute the steering vector, move, then contact/attack/animation
+        FOLLOW,     // Move on the cached steering vector, then contact/attack/animation
+        COAST,      // Off screen: move on the cached vector only
+        GROUP       // Far: placed by its group, no crowd collision
+    };
+    static constexpr float NEAR_TIER_MARGIN = 64.0f;
+    static constexpr float MID_TIER_BAND = 128.0f;
+    static constexpr int MID_STEER_INTERVAL = 4;
+    static constexpr float GROUP_CELL_SIZE = 256.0f;
+    static constexpr float GROUP_JOIN_MARGIN = 32.0f;     // Join this far past the split radius, so nobody flickers
+    static constexpr float DEFAULT_VIEW_RADIUS = Camera::REFERENCE_VIEW_RADIUS;  // Used without a camera
+    static constexpr float MIN_GROUP_BAND = 192.0f;
+    // Checked at the reference view. A wider view scales RECYCLE_DISTANCE and OPTIMAL_DISTANCE
+    // with its radius while the margins stay fixed, so the far band only gets wider.
+    static_assert(DEFAULT_VIEW_RADIUS + NEAR_TIER_MARGIN + MID_TIER_BAND + GROUP_JOIN_MARGIN + MIN_GROUP_BAND
+                      <= RECYCLE_DISTANCE,
+                  "The far tier must cover a real band before zombies are recycled");
+    // Repositioning only moves ungrouped zombies inside the far tier, so it has to start off
+    // screen and land them before they would be recycled
+    static_assert(DEFAULT_VIEW_RADIUS + NEAR_TIER_MARGIN <= OPTIMAL_DISTANCE &&
+                      OPTIMAL_DISTANCE < DEFAULT_VIEW_RADIUS + NEAR_TIER_MARGIN + MID_TIER_BAND + GROUP_JOIN_MARGIN &&
+                      OPTIMAL_DISTANCE * (1.0f + REPOSITION_SPREAD) < RECYCLE_DISTANCE,
+                  "OPTIMAL_DISTANCE must sit between the full-detail tier and the far tier");
+    float farTierRadius;    // Join radius from the last ClassifyLanes; zombies beyond it are grouped
+    float distanceScale;    // Camera::GetDistanceScale this tick; multiplies the recycle and reposition distances
+    struct FarGroup {
+        float anchorSumX, anchorSumY;   // Sum of member anchors; centroid = anchorSum / count + offset
+        float offsetX, offsetY;         // How far the group has moved since it formed
+        float speedSum;
+        float velocityX, velocityY;     // Handed to the members when the group splits
+        float rotation;
+        int count;                      // 0 while the entry is on freeGroups
+        bool splitting;                 // A member came inside the group radius this tick
+    };
+    std::vector<FarGroup> farGroups;
+    std::vector<int> freeGroups;
+    std::vector<std::pair<long long, int>> groupCells;  // (centroid cell key, group), sorted, for joining
+    std::vector<int> groupOf;                           // Group of each slot, -1 when on its own
+    std::vector<float> groupAnchorX, groupAnchorY;
+    // Steering is cached per zombie as its velocity. Near zombies recompute it one tick in
+    // steeringInterval (a rotating subset) and follow the cached vector otherwise; mid-tier zombies
+    // recompute MID_STEER_INTERVAL times less often. The interval grows while the smoothed count of
+    // neighbor visits (the bulk of the steering cost) is over AI_WORK_BUDGET and shrinks again once
+    // it is well under. Work is counted, not timed, so the same seed and inputs pick the same
+    // interval on any machine and a replay stays exact.
+    static constexpr float AI_WORK_BUDGET = 40000.0f;    // About the old 2 ms budget on two threads
+    static constexpr int MAX_STEERING_INTERVAL = 8;
+    static constexpr unsigned ADAPT_EVERY_TICKS = 15;   // Let the smoothed work settle between changes
+    int steeringInterval;
+    float aiMicroseconds;
+    float aiWork;
+    size_t steeredLastTick;
+    std::vector<Uint8> laneActions;                   // LaneAction per lane this tick
+    std::vector<std::pair<long long, int>> farMembers; // (cell key, slot) of zombies joining a group this tick
+    unsigned tickCount;
+
+    // Crowd collision. Every zombie outside the far tier is a circle, and the player is a static
+    // one. After movement, contacts are found once through a grid sized for the colliders (at most
+    // MAX_CONTACTS per zombie) and resolved by CROWD_ITERATIONS Jacobi relaxation passes, so the
+    // cost is capped at bodies * MAX_CONTACTS * CROWD_ITERATIONS. Each pass reads only the previous
+    // one, so it runs in parallel and gives the same result on any number of threads.
+    static constexpr int CROWD_ITERATIONS = 3;
+    static constexpr int MAX_CONTACTS = 8;
+    static constexpr float CROWD_RELAXATION = 1.5f;     // Over-relaxation of the averaged correction
+    static constexpr float COLLIDER_SCALE = 0.8f;       // Collider radius relative to half the hitbox
+    static constexpr float PLAYER_COLLIDER_RADIUS = 10.0f; // Inside the player's hitbox, so contact still lands attacks
+    static constexpr float COLLISION_CELL_SIZE = 64.0f;
+    SpatialGrid collisionGrid;
+    float colliderRadius;
+    std::vector<int> bodySlots;                 // Slot of each collision body this tick
+    std::vector<float> bodyX, bodyY;            // Positions being relaxed
+    std::vector<float> correctionX, correctionY;
+    std::vector<int> contacts;                  // MAX_CONTACTS entries per body
+    std::vector<int> contactCounts;
+
+    void ReserveCapacity(size_t capacity);
+    int AcquireSlot();
+    void ReleaseSlot(int slot);
+    bool Grow();
+
     bool IsZombieTooFar(const Zombie* zombie, const Player* player, float maxDistance) const;
     void UpdateZombieDistances(Player* player);
-    SDL_Point GetOptimalSpawnPosition(Player* player) const;
+    SDL_Point GetOptimalSpawnPosition(Player* player);
+    void BuildNeighborGrid();
+    void GatherNeighbors(size_t index, WorkerScratch& scratch);
+    void ClassifyLanes(const Player* player, const Camera* camera);
+    void JoinFarGroups();
+    void JoinGroup(int slot, int group);
+    void LeaveGroup(int slot);
+    void MoveFarGroups(const Player* player, float deltaTime);
+    void AdaptSteeringInterval(float neighborVisits);
+    void ResolveCrowdCollisions(const Player* player);
 };
\ No newline at end of file
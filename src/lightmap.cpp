@@ -0,0 +1,240 @@
+#include "include/LightMap.h"
+#include "include/Camera.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+LightMap::LightMap(SDL_Renderer* renderer)
+    : renderer(renderer), lightTexture(nullptr), pointSprite(nullptr), coneSprite(nullptr),
+      textureWidth(0), textureHeight(0),
+      ambientR(255.0f), ambientG(255.0f), ambientB(255.0f), targetAmbient({255, 255, 255, 255}),
+      lightCount(0), flashCount(0) {
+    pointSprite = CreatePointSprite();
+    coneSprite = CreateConeSprite();
+}
+
+LightMap::~LightMap() {
+    if (lightTexture) SDL_DestroyTexture(lightTexture);
+    if (pointSprite) SDL_DestroyTexture(pointSprite);
+    if (coneSprite) SDL_DestroyTexture(coneSprite);
+}
+
+SDL_Texture* LightMap::CreatePointSprite() {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SPRITE_SIZE, SPRITE_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        std::cerr << "LightMap: Failed to create point light surface: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    int pitch = surface->pitch / 4;
+    float center = SPRITE_SIZE / 2.0f;
+    for (int py = 0; py < SPRITE_SIZE; ++py) {
+        for (int px = 0; px < SPRITE_SIZE; ++px) {
+            float dx = (px + 0.5f - center) / center;
+            float dy = (py + 0.5f - center) / center;
+            float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy));
+            Uint8 value = static_cast<Uint8>(255.0f * falloff * falloff); // Quadratic falloff looks softer
+            pixels[py * pitch + px] = SDL_MapRGBA(surface->format, value, value, value, 255);
+        }
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD);
+    }
+    return texture;
+}
+
+SDL_Texture* LightMap::CreateConeSprite() {
+    // The beam starts at the left-center of the sprite and points along +X. One sprite side is the
+    // light's radius; the beam is only clipped across near its tip, where it has already faded out.
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SPRITE_SIZE, SPRITE_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        std::cerr << "LightMap: Failed to create cone light surface: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    int pitch = surface->pitch / 4;
+    float originY = SPRITE_SIZE / 2.0f;
+    float halfAngleRad = CONE_HALF_ANGLE * M_PI / 180.0f;
+    for (int py = 0; py < SPRITE_SIZE; ++py) {
+        for (int px = 0; px < SPRITE_SIZE; ++px) {
+            float dx = (px + 0.5f) / SPRITE_SIZE;
+            float dy = (py + 0.5f - originY) / SPRITE_SIZE;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float angle = std::fabs(std::atan2(dy, dx));
+            float radial = std::max(0.0f, 1.0f - distance);
+            float angular = std::max(0.0f, 1.0f - angle / halfAngleRad); // Soft beam edges
+            Uint8 value = static_cast<Uint8>(255.0f * radial * std::min(1.0f, angular * 2.0f));
+            pixels[py * pitch + px] = SDL_MapRGBA(surface->format, value, value, value, 255);
+        }
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD);
+    }
+    return texture;
+}
+
+bool LightMap::EnsureTarget(int screenWidth, int screenHeight) {
+    int width = std::max(1, screenWidth / RESOLUTION_DIVISOR);
+    int height = std::max(1, screenHeight / RESOLUTION_DIVISOR);
+    if (lightTexture && width == textureWidth && height == textureHeight) {
+        return true;
+    }
+
+    // Window size changed (or first frame): rebuild the accumulation target
+    if (lightTexture) {
+        SDL_DestroyTexture(lightTexture);
+        lightTexture = nullptr;
+    }
+    lightTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!lightTexture) {
+        std::cerr << "LightMap: Failed to create light texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(lightTexture, SDL_BLENDMODE_MOD);
+    SDL_SetTextureScaleMode(lightTexture, SDL_ScaleModeLinear); // Upscale smoothly over the world
+    textureWidth = width;
+    textureHeight = height;
+    return true;
+}
+
+bool LightMap::AddLight(const Light& light) {
+    if (lightCount >= MAX_LIGHTS) {
+        return false;
+    }
+    lights[lightCount++] = light;
+    return true;
+}
+
+void LightMap::AddFlash(float x, float y, float radius, SDL_Color color, float duration) {
+    Flash flash = {x, y, radius, color, duration, duration};
+    if (flashCount < MAX_FLASHES) {
+        flashes[flashCount++] = flash;
+        return;
+    }
+
+    // Full: replace the flash closest to expiring
+    int oldest = 0;
+    for (int i = 1; i < flashCount; ++i) {
+        if (flashes[i].timeLeft < flashes[oldest].timeLeft) {
+            oldest = i;
+        }
+    }
+    flashes[oldest] = flash;
+}
+
+bool LightMap::IsDark() const {
+    return ambientR < 254.0f || ambientG < 254.0f || ambientB < 254.0f;
+}
+
+void LightMap::Update(float deltaTime) {
+    // Fade ambient toward the target
+    float step = AMBIENT_FADE_SPEED * deltaTime;
+    auto approach = [step](float current, float target) {
+        if (current < target) return std::min(target, current + step);
+        return std::max(target, current - step);
+    };
+    ambientR = approach(ambientR, targetAmbient.r);
+    ambientG = approach(ambientG, targetAmbient.g);
+    ambientB = approach(ambientB, targetAmbient.b);
+
+    // Age flashes, swap-removing expired ones
+    for (int i = 0; i < flashCount;) {
+        flashes[i].timeLeft -= deltaTime;
+        if (flashes[i].timeLeft <= 0.0f) {
+            flashes[i] = flashes[--flashCount];
+        } else {
+            ++i;
+        }
+    }
+}
+
+void LightMap::DrawLight(const Light& light, const Camera* camera, int screenWidth, int screenHeight) {
+    // Cull lights whose reach does not touch the screen
+    SDL_FPoint screenPos = camera->WorldToScreen(light.x, light.y);
+    float screenX = screenPos.x;
+    float screenY = screenPos.y;
+    float radius = light.radius * camera->GetZoom();
+    if (screenX + radius < 0 || screenX - radius > screenWidth ||
+        screenY + radius < 0 || screenY - radius > screenHeight) {
+        return;
+    }
+
+    float intensity = std::max(0.0f, std::min(1.0f, light.intensity));
+    float scale = 1.0f / RESOLUTION_DIVISOR;
+
+    if (light.shape == LightShape::CONE) {
+        if (!coneSprite) return;
+        SDL_SetTextureColorMod(coneSprite,
+            static_cast<Uint8>(light.color.r * intensity),
+            static_cast<Uint8>(light.color.g * intensity),
+            static_cast<Uint8>(light.color.b * intensity));
+        // The sprite is baked square (radius along the beam, radius/2 to either side), so it is
+        // drawn square too and rotated around its left-center origin
+        SDL_Rect dst = {
+            static_cast<int>(screenX * scale),
+            static_cast<int>((screenY - 0.5f * radius) * scale),
+            static_cast<int>(radius * scale),
+            static_cast<int>(radius * scale)
+        };
+        SDL_Point origin = {0, dst.h / 2};
+        SDL_RenderCopyEx(renderer, coneSprite, nullptr, &dst, light.angle, &origin, SDL_FLIP_NONE);
+    } else {
+        if (!pointSprite) return;
+        SDL_SetTextureColorMod(pointSprite,
+            static_cast<Uint8>(light.color.r * intensity),
+            static_cast<Uint8>(light.color.g * intensity),
+            static_cast<Uint8>(light.color.b * intensity));
+        SDL_Rect dst = {
+            static_cast<int>((screenX - radius) * scale),
+            static_cast<int>((screenY - radius) * scale),
+            static_cast<int>(2.0f * radius * scale),
+            static_cast<int>(2.0f * radius * scale)
+        };
+        SDL_RenderCopy(renderer, pointSprite, nullptr, &dst);
+    }
+}
+
+void LightMap::Render(Camera* camera) {
+    // Flashes are promoted into the per-frame list so they share the cap
+    for (int i = 0; i < flashCount; ++i) {
+        const Flash& flash = flashes[i];
+        float t = flash.timeLeft / flash.duration;
+        AddLight({flash.x, flash.y, flash.radius, 0.0f, flash.color, t, LightShape::POINT});
+    }
+
+    // Full daylight multiplies by white: skip the whole pass
+    if (!camera || !IsDark()) {
+        lightCount = 0;
+        return;
+    }
+
+    int screenWidth = camera->GetViewWidth();
+    int screenHeight = camera->GetViewHeight();
+    if (!EnsureTarget(screenWidth, screenHeight)) {
+        lightCount = 0;
+        return;
+    }
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, lightTexture);
+    SDL_SetRenderDrawColor(renderer,
+        static_cast<Uint8>(ambientR), static_cast<Uint8>(ambientG), static_cast<Uint8>(ambientB), 255);
+    SDL_RenderClear(renderer);
+
+    for (int i = 0; i < lightCount; ++i) {
+        DrawLight(lights[i], camera, screenWidth, screenHeight);
+    }
+    lightCount = 0;
+
+    // Multiply the accumulated light over everything drawn so far
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_RenderCopy(renderer, lightTexture, nullptr, nullptr);
+}
@@ -1,12 +1,37 @@
 #include "include/Game.h"
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
     Game game;
+
+    // --seed N replays a run: same seed and same inputs give the same game
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0) {
+            game.SetSeed(std::strtoull(argv[i + 1], nullptr, 10));
+        }
+    }
+    // --check-allocations flags every steady-state gameplay frame that touches the heap
+    // (profiler builds only: make CPPFLAGS=-DALLOCATION_PROFILER)
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--check-allocations") == 0) {
+            game.SetAllocationCheck(true);
+        }
+    }
+    // --scripted-waves N plays N waves unattended and exits nonzero if the run fails
+    // (see make test-allocations). Headless unless a video or audio driver is chosen explicitly.
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--scripted-waves") == 0) {
+            game.SetScriptedRun(std::atoi(argv[i + 1]));
+            SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+            SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+        }
+    }
     
     if (!game.Initialize()) {
         return 1;
     }
 
     game.Run();
-    return 0;
-}
\ No newline at end of file
+    return game.GetExitCode();
+}
@@ -0,0 +1,220 @@
+#include "include/ParticleSystem.h"
+#include "include/Camera.h"
+#include "include/Simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    float RandomRange(Pcg32* random, float minValue, float maxValue) {
+        if (!random) return (minValue + maxValue) * 0.5f;
+        return random->Range(minValue, maxValue);
+    }
+}
+
+ParticleEmitter::ParticleEmitter(SDL_Renderer* renderer, const std::string& texturePath, size_t capacity, SDL_BlendMode blendMode)
+    : renderer(renderer), texture(nullptr), capacity(capacity), count(0), drag(3.0f), random(nullptr) {
+    SDL_Surface* surface = IMG_Load(texturePath.c_str());
+    if (!surface) {
+        std::cerr << "Failed to load particle texture: " << texturePath << " Error: " << IMG_GetError() << std::endl;
+    } else {
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+        if (!texture) {
+            std::cerr << "Failed to create particle texture: " << SDL_GetError() << std::endl;
+        } else {
+            SDL_SetTextureBlendMode(texture, blendMode);
+        }
+    }
+
+    // Allocate everything once; Emit/Update never touch the heap
+    posX.resize(capacity);
+    posY.resize(capacity);
+    velX.resize(capacity);
+    velY.resize(capacity);
+    life.resize(capacity);
+    invMaxLife.resize(capacity);
+    startSize.resize(capacity);
+    endSize.resize(capacity);
+    colorR.resize(capacity);
+    colorG.resize(capacity);
+    colorB.resize(capacity);
+    vertices.resize(capacity * 4);
+    indices.resize(capacity * 6);
+
+    // Quad topology never changes, so the index buffer is built once
+    for (size_t i = 0; i < capacity; ++i) {
+        int base = static_cast<int>(i * 4);
+        indices[i * 6 + 0] = base + 0;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base + 0;
+        vertices[i * 4 + 0].tex_coord = {0.0f, 0.0f};
+        vertices[i * 4 + 1].tex_coord = {1.0f, 0.0f};
+        vertices[i * 4 + 2].tex_coord = {1.0f, 1.0f};
+        vertices[i * 4 + 3].tex_coord = {0.0f, 1.0f};
+    }
+}
+
+ParticleEmitter::~ParticleEmitter() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+void ParticleEmitter::Emit(float x, float y, float angleDeg, float spreadDeg,
+                           float minSpeed, float maxSpeed, float minLife, float maxLife,
+                           float sizeAtStart, float sizeAtEnd, SDL_Color color, int emitCount) {
+    for (int n = 0; n < emitCount; ++n) {
+        if (count >= capacity) {
+            return; // Pool is full, drop the rest of the burst
+        }
+        size_t i = count++;
+
+        float angleRad = (angleDeg + RandomRange(random, -spreadDeg / 2.0f, spreadDeg / 2.0f)) * M_PI / 180.0f;
+        float speed = RandomRange(random, minSpeed, maxSpeed);
+        float lifetime = RandomRange(random, minLife, maxLife);
+
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = std::cos(angleRad) * speed;
+        velY[i] = std::sin(angleRad) * speed;
+        life[i] = lifetime;
+        invMaxLife[i] = 1.0f / lifetime;
+        startSize[i] = sizeAtStart;
+        endSize[i] = sizeAtEnd;
+        colorR[i] = color.r;
+        colorG[i] = color.g;
+        colorB[i] = color.b;
+    }
+}
+
+void ParticleEmitter::Kill(size_t index) {
+    // Swap-remove: move the last live particle into the hole
+    size_t last = --count;
+    posX[index] = posX[last];
+    posY[index] = posY[last];
+    velX[index] = velX[last];
+    velY[index] = velY[last];
+    life[index] = life[last];
+    invMaxLife[index] = invMaxLife[last];
+    startSize[index] = startSize[last];
+    endSize[index] = endSize[last];
+    colorR[index] = colorR[last];
+    colorG[index] = colorG[last];
+    colorB[index] = colorB[last];
+}
+
+void ParticleEmitter::Update(float deltaTime) {
+    if (count == 0) return;
+
+    // Integration pass: straight-line float math with no branches, so the compiler can vectorize it
+    float damping = std::max(0.0f, 1.0f - drag * deltaTime);
+    float* px = posX.data();
+    float* py = posY.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* lt = life.data();
+    for (size_t i = 0; i < count; ++i) {
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        vx[i] *= damping;
+        vy[i] *= damping;
+        lt[i] -= deltaTime;
+    }
+
+    // Compaction pass: expired particles are swap-removed
+    for (size_t i = 0; i < count;) {
+        if (lt[i] <= 0.0f) {
+            Kill(i); // Re-check index i, it now holds what was the last particle
+        } else {
+            ++i;
+        }
+    }
+}
+
+void ParticleEmitter::Render(Camera* camera) {
+    if (count == 0 || !texture || !camera) return;
+
+    float camX = camera->GetX();
+    float camY = camera->GetY();
+
+    for (size_t i = 0; i < count; ++i) {
+        float t = life[i] * invMaxLife[i]; // 1 at birth, 0 at death
+        float half = 0.5f * (endSize[i] + (startSize[i] - endSize[i]) * t);
+        float cx = posX[i] - camX;
+        float cy = posY[i] - camY;
+        SDL_Color color = {colorR[i], colorG[i], colorB[i], static_cast<Uint8>(255.0f * t)};
+
+        SDL_Vertex* quad = &vertices[i * 4];
+        quad[0].position = {cx - half, cy - half};
+        quad[1].position = {cx + half, cy - half};
+        quad[2].position = {cx + half, cy + half};
+        quad[3].position = {cx - half, cy + half};
+        quad[0].color = color;
+        quad[1].color = color;
+        quad[2].color = color;
+        quad[3].color = color;
+    }
+
+    SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(count * 4),
+                       indices.data(), static_cast<int>(count * 6));
+}
+
+ParticleSystem::ParticleSystem(SDL_Renderer* renderer)
+    : flashEmitter(nullptr), impactEmitter(nullptr) {
+    flashEmitter = new ParticleEmitter(renderer, "assets/fire.png", FLASH_CAPACITY, SDL_BLENDMODE_ADD);
+    flashEmitter->SetDrag(6.0f);
+    impactEmitter = new ParticleEmitter(renderer, "assets/fire.png", IMPACT_CAPACITY, SDL_BLENDMODE_BLEND);
+    impactEmitter->SetDrag(4.0f);
+}
+
+ParticleSystem::~ParticleSystem() {
+    delete flashEmitter;
+    delete impactEmitter;
+}
+
+void ParticleSystem::SetRandom(Pcg32* stream) {
+    flashEmitter->SetRandom(stream);
+    impactEmitter->SetRandom(stream);
+}
+
+void ParticleSystem::EmitMuzzleFlash(float x, float y, float rotationDeg, int particleCount) {
+    // Bright core that barely moves, plus a fan of fast sparks along the barrel
+    SDL_Color core = {255, 220, 140, 255};
+    SDL_Color sparks = {255, 150, 40, 255};
+    flashEmitter->Emit(x, y, rotationDeg, 20.0f, 0.0f, 40.0f, 0.04f, 0.08f, 28.0f, 12.0f, core, 2);
+    flashEmitter->Emit(x, y, rotationDeg, 35.0f, 250.0f, 600.0f, 0.05f, 0.15f, 10.0f, 2.0f, sparks, particleCount);
+}
+
+void ParticleSystem::EmitImpact(float x, float y, float bulletRotationDeg, bool isShotgunPellet) {
+    // Splatter continues along the bullet's path, sparks kick back toward the shooter
+    SDL_Color blood = {150, 10, 10, 255};
+    SDL_Color sparks = {255, 180, 60, 255};
+    int splatterCount = isShotgunPellet ? 8 : 14;
+    impactEmitter->Emit(x, y, bulletRotationDeg, 70.0f, 60.0f, 220.0f, 0.2f, 0.45f, 10.0f, 4.0f, blood, splatterCount);
+    flashEmitter->Emit(x, y, bulletRotationDeg + 180.0f, 90.0f, 100.0f, 300.0f, 0.05f, 0.12f, 8.0f, 2.0f, sparks, 4);
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    flashEmitter->Update(deltaTime);
+    impactEmitter->Update(deltaTime);
+}
+
+void ParticleSystem::Render(Camera* camera) {
+    // Splatter underneath, additive flashes on top
+    impactEmitter->Render(camera);
+    flashEmitter->Render(camera);
+}
+
+void ParticleSystem::Clear() {
+    flashEmitter->Clear();
+    impactEmitter->Clear();
+}
+
+size_t ParticleSystem::GetParticleCount() const {
+    return flashEmitter->GetCount() + impactEmitter->GetCount();
+}
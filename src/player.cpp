@@ -1,7 +1,9 @@
 #include "include/Player.h"
-#include "include/Bullet.h"
 #include "include/Camera.h"
 #include "include/WeaponConfig.h"
+#include "include/ParticleSystem.h"
+#include "include/LightMap.h"
+#include "include/Simulation.h"
 #include <iostream>
 #include <cmath>
 
@@ -14,16 +16,16 @@ Player::Player(SDL_Renderer* renderer, WaveManager* waveManager, UI* ui, float s
     currentHealth(STARTING_HEALTH), showDebugVisuals(false), showDebugHitbox(false), 
     showDebugAimingLine(false), showDebugMuzzlePosition(false), soundEnabled(true),
     pistolShotSound(nullptr), rifleShotSound(nullptr), shotgunShotSound(nullptr),
-    pistolReloadSound(nullptr), rifleReloadSound(nullptr), shotgunReloadSound(nullptr) {
+    pistolReloadSound(nullptr), rifleReloadSound(nullptr), shotgunReloadSound(nullptr),
+    particleSystem(nullptr), lightMap(nullptr), random(nullptr) {
+
+    projectiles = new ProjectileSystem(renderer);
     
     // Initialize key states
     for (bool& state : keyStates) {
         state = false;
     }
 
-    // Initialize random seed for shotgun spread
-    srand(static_cast<unsigned>(time(nullptr)));
-
     // Set up source and destination rectangles    
     srcRect = {0, 0, 0, 0};
     destRect = {0, 0, 48, 48}; // Player size reduced from 64x64 to 48x48 pixels
@@ -57,10 +59,8 @@ Player::~Player() {
     }
 
     // Clean up bullets
-    for (auto bullet : bullets) {
-        delete bullet;
-    }
-    bullets.clear();
+    delete projectiles;
+    projectiles = nullptr;
     
     // Clean up sound effects
     if (pistolShotSound) Mix_FreeChunk(pistolShotSound);
@@ -380,13 +380,6 @@ void Player::Update(float deltaTime) {
 void Player::Shoot() {
     if (isReloading) return;
 
-    // Add bullet limit check
-    static const size_t MAX_ACTIVE_BULLETS = 1000;
-    if (bullets.size() >= MAX_ACTIVE_BULLETS) {
-        std::cerr << "Warning: Maximum bullet limit reached" << std::endl;
-        return;
-    }
-
     bool canShoot = false;
     switch (currentWeapon) {
         case WeaponType::PISTOL:
@@ -446,18 +439,31 @@ void Player::Shoot() {
     float rotationRad = rotation * M_PI / 180.0f;
     float muzzleX = x + (muzzleOffsetX * cos(rotationRad)) - (muzzleOffsetY * sin(rotationRad));
     float muzzleY = y + (muzzleOffsetX * sin(rotationRad)) + (muzzleOffsetY * cos(rotationRad));
+
+    if (particleSystem) {
+        int muzzleParticles = WeaponConfig::Pistol::MUZZLE_PARTICLES;
+        if (currentWeapon == WeaponType::RIFLE) {
+            muzzleParticles = WeaponConfig::Rifle::MUZZLE_PARTICLES;
+        } else if (currentWeapon == WeaponType::SHOTGUN) {
+            muzzleParticles = WeaponConfig::Shotgun::MUZZLE_PARTICLES;
+        }
+        particleSystem->EmitMuzzleFlash(muzzleX, muzzleY, rotation, muzzleParticles);
+    }
+    if (lightMap) {
+        float flashRadius = (currentWeapon == WeaponType::SHOTGUN) ? 260.0f : 180.0f;
+        lightMap->AddFlash(muzzleX, muzzleY, flashRadius, {255, 200, 120, 255}, 0.07f);
+    }
       if (currentWeapon == WeaponType::SHOTGUN) {
         // Create multiple pellets with spread
         for (int i = 0; i < WeaponConfig::Shotgun::PELLET_COUNT; i++) {
-            float spreadAngle = rotation + (((float)rand() / RAND_MAX) * WeaponConfig::Shotgun::SPREAD_ANGLE - WeaponConfig::Shotgun::SPREAD_ANGLE / 2);
-            Bullet* pellet = new Bullet(renderer, muzzleX, muzzleY, spreadAngle, BulletType::SHOTGUN_PELLET);
-            bullets.push_back(pellet);
+            float spread = random ? random->NextFloat() : 0.5f;
+            float spreadAngle = rotation + (spread * WeaponConfig::Shotgun::SPREAD_ANGLE - WeaponConfig::Shotgun::SPREAD_ANGLE / 2);
+            projectiles->Spawn(BulletType::SHOTGUN_PELLET, muzzleX, muzzleY, spreadAngle);
         }
     } else {
         // Single bullet for other weapons
         BulletType bulletType = (currentWeapon == WeaponType::RIFLE) ? BulletType::RIFLE : BulletType::PISTOL;
-        Bullet* bullet = new Bullet(renderer, muzzleX, muzzleY, rotation, bulletType);
-        bullets.push_back(bullet);
+        projectiles->Spawn(bulletType, muzzleX, muzzleY, rotation);
     }
 
     // Decrease ammo and set fire rate timer
@@ -557,11 +563,11 @@ void Player::RenderAimingLine(SDL_Renderer* renderer, Camera* camera) {
     float playerWorldCenterX = GetCenterX();
     float playerWorldCenterY = GetCenterY();
 
-    // Convert player's world center to screen coordinates
-    SDL_FPoint playerScreenCenter = camera->WorldToScreen(playerWorldCenterX, playerWorldCenterY);
+    // Convert player's world center to camera-relative coordinates (the world pass applies zoom)
+    SDL_FPoint playerScreenCenter = {playerWorldCenterX - camera->GetX(), playerWorldCenterY - camera->GetY()};
 
-    // Mouse position is already in world coordinates, convert to screen coordinates for rendering the line end point
-    SDL_FPoint mouseScreenPos = camera->WorldToScreen(static_cast<float>(mouseX), static_cast<float>(mouseY));
+    // Mouse position is already in world coordinates, make it camera-relative for the line end point
+    SDL_FPoint mouseScreenPos = {mouseX - camera->GetX(), mouseY - camera->GetY()};
     
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
     SDL_RenderDrawLine(renderer, 
@@ -578,8 +584,8 @@ void Player::RenderMuzzlePosition(SDL_Renderer* renderer, Camera* camera) {
     float worldMuzzleX = GetCenterX() + (PISTOL_MUZZLE_OFFSET_X * cos(rotationRad)) - (PISTOL_MUZZLE_OFFSET_Y * sin(rotationRad));
     float worldMuzzleY = GetCenterY() + (PISTOL_MUZZLE_OFFSET_X * sin(rotationRad)) + (PISTOL_MUZZLE_OFFSET_Y * cos(rotationRad));
     
-    // Convert world muzzle position to screen position
-    SDL_FPoint screenMuzzlePos = camera->WorldToScreen(worldMuzzleX, worldMuzzleY);
+    // Convert world muzzle position to camera-relative position (the world pass applies zoom)
+    SDL_FPoint screenMuzzlePos = {worldMuzzleX - camera->GetX(), worldMuzzleY - camera->GetY()};
 
     SDL_Rect muzzleRect = {
         static_cast<int>(screenMuzzlePos.x) - 2,
@@ -594,9 +600,7 @@ void Player::RenderMuzzlePosition(SDL_Renderer* renderer, Camera* camera) {
 
 void Player::Render(SDL_Renderer* renderer, Camera* camera) {
     // Render bullets first, passing the camera
-    for (auto bullet : bullets) {
-        bullet->Render(renderer, camera);
-    }
+    projectiles->Render(camera);
 
     // Get the current animation frames
     auto& currentFrames = GetCurrentAnimationFrames();
@@ -660,17 +664,8 @@ float Player::GetCenterY() const {
 }
 
 void Player::UpdateBullets(float deltaTime, Camera* camera) {
-    for (auto it = bullets.begin(); it != bullets.end();) {
-        Bullet* bullet = *it;
-        bullet->Update(deltaTime);
-        
-        if (!bullet->IsActive()) {
-            delete bullet;
-            it = bullets.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // Moves every projectile and swap-removes the ones past their type's range
+    projectiles->Update(deltaTime);
 }
 
 void Player::TakeDamage(int amount) {
@@ -0,0 +1,258 @@
+#include "include/ProjectileSystem.h"
+#include "include/Camera.h"
+#include <cmath>
+#include <iostream>
+
+// SSE2 is part of every x86-64 target, so unlike the steering kernels this needs no runtime dispatch
+#if defined(__SSE2__)
+#define PROJECTILE_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define PROJECTILE_SIMD_SSE 0
+#endif
+
+namespace {
+    template <BulletType Type>
+    BulletEffect EffectOf() {
+        using Traits = BulletTraits<Type>;
+        return {Traits::DAMAGE, Traits::KNOCKBACK_FORCE, Traits::KNOCKBACK_DURATION};
+    }
+
+    template <BulletType Type>
+    void UpdateLane(ProjectileLane& lane, float deltaTime) {
+        using Traits = BulletTraits<Type>;
+        if (lane.count == 0) return;
+
+        // Every projectile of the type covers the same distance per step, so range is a
+        // subtraction instead of a square root
+        const float step = Traits::SPEED * deltaTime;
+        float* px = lane.x.data();
+        float* py = lane.y.data();
+        float* ox = lane.prevX.data();
+        float* oy = lane.prevY.data();
+        const float* dx = lane.dirX.data();
+        const float* dy = lane.dirY.data();
+        float* left = lane.remaining.data();
+        const size_t n = lane.count;
+
+        // Capacities are multiples of four, so rounding up only touches unused slots and the
+        // SIMD loop needs no scalar tail
+        static_assert(Traits::CAPACITY % 4 == 0, "lane capacity must be a multiple of 4");
+        const size_t padded = (n + 3) & ~static_cast<size_t>(3);
+#if PROJECTILE_SIMD_SSE
+        const __m128 stepVec = _mm_set1_ps(step);
+        for (size_t i = 0; i < padded; i += 4) {
+            __m128 oldX = _mm_loadu_ps(px + i);
+            __m128 oldY = _mm_loadu_ps(py + i);
+            _mm_storeu_ps(ox + i, oldX);
+            _mm_storeu_ps(oy + i, oldY);
+            _mm_storeu_ps(px + i, _mm_add_ps(oldX, _mm_mul_ps(_mm_loadu_ps(dx + i), stepVec)));
+            _mm_storeu_ps(py + i, _mm_add_ps(oldY, _mm_mul_ps(_mm_loadu_ps(dy + i), stepVec)));
+            _mm_storeu_ps(left + i, _mm_sub_ps(_mm_loadu_ps(left + i), stepVec));
+        }
+#else
+        for (size_t i = 0; i < padded; ++i) {
+            ox[i] = px[i];
+            oy[i] = py[i];
+            px[i] += dx[i] * step;
+            py[i] += dy[i] * step;
+            left[i] -= step;
+        }
+#endif
+
+        // Expiry pass, back to front so whatever Kill swaps in has already been checked
+        for (size_t i = n; i-- > 0;) {
+            if (left[i] <= 0.0f) {
+                lane.Kill(i);
+            }
+        }
+    }
+
+    template <BulletType Type>
+    void AllocateLane(ProjectileLane& lane) {
+        static_assert(BulletTraits<Type>::CAPACITY <= 65536, "lane ids must fit below the handle's lane bits");
+        lane.Allocate(BulletTraits<Type>::CAPACITY);
+    }
+}
+
+BulletEffect GetBulletEffect(BulletType type) {
+    switch (type) {
+        case BulletType::RIFLE:
+            return EffectOf<BulletType::RIFLE>();
+        case BulletType::SHOTGUN_PELLET:
+            return EffectOf<BulletType::SHOTGUN_PELLET>();
+        case BulletType::PISTOL:
+        default:
+            return EffectOf<BulletType::PISTOL>();
+    }
+}
+
+void ProjectileLane::Allocate(size_t newCapacity) {
+    capacity = newCapacity;
+    count = 0;
+    x.resize(capacity);
+    y.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    dirX.resize(capacity);
+    dirY.resize(capacity);
+    rotation.resize(capacity);
+    remaining.resize(capacity);
+    id.resize(capacity);
+    indexOfId.assign(capacity, -1);
+    generationOfId.assign(capacity, 1);
+    freeIds.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        freeIds[i] = static_cast<int>(capacity - 1 - i);    // Hand out low ids first
+    }
+}
+
+size_t ProjectileLane::Add() {
+    size_t index = count++;
+    int newId = freeIds.back();
+    freeIds.pop_back();
+    id[index] = newId;
+    indexOfId[newId] = static_cast<int>(index);
+    return index;
+}
+
+void ProjectileLane::Kill(size_t index) {
+    // The id is freed and its generation bumped, so handles to this projectile go stale
+    int deadId = id[index];
+    indexOfId[deadId] = -1;
+    generationOfId[deadId]++;
+    freeIds.push_back(deadId);
+
+    // Swap-remove: move the last live projectile into the hole
+    size_t last = --count;
+    id[index] = id[last];
+    if (index != last) {
+        indexOfId[id[index]] = static_cast<int>(index);
+    }
+    x[index] = x[last];
+    y[index] = y[last];
+    prevX[index] = prevX[last];
+    prevY[index] = prevY[last];
+    dirX[index] = dirX[last];
+    dirY[index] = dirY[last];
+    rotation[index] = rotation[last];
+    remaining[index] = remaining[last];
+}
+
+ProjectileSystem::ProjectileSystem(SDL_Renderer* renderer)
+    : renderer(renderer), texture(nullptr), srcRect{0, 0, 0, 0} {
+    // One texture for every projectile, loaded once instead of per shot
+    SDL_Surface* surface = IMG_Load("assets/bullet.png");
+    if (!surface) {
+        std::cerr << "Failed to load bullet image: " << IMG_GetError() << std::endl;
+    } else {
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+        if (!texture) {
+            std::cerr << "Failed to create bullet texture: " << SDL_GetError() << std::endl;
+        } else {
+            srcRect = {0, 0, surface->w, surface->h};
+        }
+        SDL_FreeSurface(surface);
+    }
+
+    AllocateLane<BulletType::PISTOL>(GetLane(BulletType::PISTOL));
+    AllocateLane<BulletType::RIFLE>(GetLane(BulletType::RIFLE));
+    AllocateLane<BulletType::SHOTGUN_PELLET>(GetLane(BulletType::SHOTGUN_PELLET));
+}
+
+ProjectileSystem::~ProjectileSystem() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+ProjectileHandle ProjectileSystem::Spawn(BulletType type, float x, float y, float angleDeg) {
+    if (type == BulletType::COUNT) return ProjectileHandle();
+    ProjectileLane& lane = GetLane(type);
+    if (lane.count >= lane.capacity) {
+        return ProjectileHandle();
+    }
+
+    float maxDistance = BulletTraits<BulletType::PISTOL>::MAX_DISTANCE;
+    if (type == BulletType::RIFLE) {
+        maxDistance = BulletTraits<BulletType::RIFLE>::MAX_DISTANCE;
+    } else if (type == BulletType::SHOTGUN_PELLET) {
+        maxDistance = BulletTraits<BulletType::SHOTGUN_PELLET>::MAX_DISTANCE;
+    }
+
+    size_t i = lane.Add();
+    float angleRad = angleDeg * M_PI / 180.0f;
+    lane.x[i] = x;
+    lane.y[i] = y;
+    lane.prevX[i] = x;  // A new shot's first step starts at the muzzle
+    lane.prevY[i] = y;
+    lane.dirX[i] = std::cos(angleRad);
+    lane.dirY[i] = std::sin(angleRad);
+    lane.rotation[i] = angleDeg;
+    lane.remaining[i] = maxDistance;
+    return GetHandle(type, i);
+}
+
+void ProjectileSystem::Update(float deltaTime) {
+    UpdateLane<BulletType::PISTOL>(GetLane(BulletType::PISTOL), deltaTime);
+    UpdateLane<BulletType::RIFLE>(GetLane(BulletType::RIFLE), deltaTime);
+    UpdateLane<BulletType::SHOTGUN_PELLET>(GetLane(BulletType::SHOTGUN_PELLET), deltaTime);
+}
+
+void ProjectileSystem::Render(Camera* camera) {
+    if (!texture || !camera) return;
+
+    SDL_Point center = {BULLET_SIZE / 2, BULLET_SIZE / 2};
+    for (const ProjectileLane& lane : lanes) {
+        for (size_t i = 0; i < lane.count; ++i) {
+            SDL_Rect screenDestRect = GetHitbox(lane.x[i], lane.y[i]);
+            screenDestRect.x = static_cast<int>(screenDestRect.x - camera->GetX());
+            screenDestRect.y = static_cast<int>(screenDestRect.y - camera->GetY());
+            SDL_RenderCopyEx(renderer, texture, &srcRect, &screenDestRect, lane.rotation[i], &center, SDL_FLIP_NONE);
+        }
+    }
+}
+
+void ProjectileSystem::Clear() {
+    for (ProjectileLane& lane : lanes) {
+        while (lane.count > 0) {
+            lane.Kill(lane.count - 1);
+        }
+    }
+}
+
+ProjectileHandle ProjectileSystem::GetHandle(BulletType type, size_t index) const {
+    ProjectileHandle handle;
+    const ProjectileLane& lane = GetLane(type);
+    if (index >= lane.count) return handle;
+    int laneId = lane.id[index];
+    handle.index = (static_cast<int>(type) << LANE_SHIFT) | laneId;
+    handle.generation = lane.generationOfId[laneId];
+    return handle;
+}
+
+bool ProjectileSystem::IsAlive(ProjectileHandle handle) const {
+    if (handle.IsNull()) return false;
+    int laneIndex = handle.index >> LANE_SHIFT;
+    int laneId = handle.index & ((1 << LANE_SHIFT) - 1);
+    if (laneIndex >= static_cast<int>(BulletType::COUNT)) return false;
+    const ProjectileLane& lane = lanes[laneIndex];
+    if (laneId >= static_cast<int>(lane.capacity)) return false;
+    return lane.generationOfId[laneId] == handle.generation && lane.indexOfId[laneId] >= 0;
+}
+
+bool ProjectileSystem::Kill(ProjectileHandle handle) {
+    if (!IsAlive(handle)) return false;
+    ProjectileLane& lane = lanes[handle.index >> LANE_SHIFT];
+    lane.Kill(static_cast<size_t>(lane.indexOfId[handle.index & ((1 << LANE_SHIFT) - 1)]));
+    return true;
+}
+
+size_t ProjectileSystem::GetCount() const {
+    size_t total = 0;
+    for (const ProjectileLane& lane : lanes) {
+        total += lane.count;
+    }
+    return total;
+}
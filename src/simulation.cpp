@@ -0,0 +1,62 @@
+#include "include/Simulation.h"
+
+Pcg32::Pcg32(uint64_t seed, uint64_t stream) : state(0), increment(1) {
+    Seed(seed, stream);
+}
+
+void Pcg32::Seed(uint64_t seed, uint64_t stream) {
+    // Reference pcg32_srandom_r initialization
+    state = 0;
+    increment = (stream << 1u) | 1u;
+    Next();
+    state += seed;
+    Next();
+}
+
+uint32_t Pcg32::Next() {
+    uint64_t oldState = state;
+    state = oldState * 6364136223846793005ULL + increment;
+    uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+}
+
+float Pcg32::NextFloat() {
+    // Top 24 bits fill a float mantissa exactly, so the result never rounds up to 1
+    return (Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+float Pcg32::Range(float minValue, float maxValue) {
+    return minValue + NextFloat() * (maxValue - minValue);
+}
+
+int Pcg32::RangeInt(int minValue, int maxValue) {
+    if (maxValue <= minValue) return minValue;
+    uint32_t bound = static_cast<uint32_t>(maxValue - minValue) + 1u;
+    // Reject the low values that would make some results more likely than others
+    uint32_t threshold = (0u - bound) % bound;
+    while (true) {
+        uint32_t value = Next();
+        if (value >= threshold) {
+            return minValue + static_cast<int>(value % bound);
+        }
+    }
+}
+
+Simulation::Simulation(uint64_t seed) : seed(seed), tick(0), timeSeconds(0.0) {
+    Reset(seed);
+}
+
+void Simulation::Reset(uint64_t newSeed) {
+    seed = newSeed;
+    tick = 0;
+    timeSeconds = 0.0;
+    for (int i = 0; i < static_cast<int>(RandomStream::COUNT); ++i) {
+        streams[i].Seed(seed, static_cast<uint64_t>(i) + 1u);
+    }
+}
+
+void Simulation::Step(float fixedStep) {
+    tick++;
+    timeSeconds += fixedStep;
+}
@@ -0,0 +1,128 @@
+#include "include/SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+SpatialGrid::SpatialGrid(float cellSize, size_t bucketCount)
+    : cellSize(cellSize), inverseCellSize(1.0f / cellSize), bucketMask(0) {
+    // Round the bucket count up to a power of two
+    size_t buckets = 1;
+    while (buckets < bucketCount) {
+        buckets <<= 1;
+    }
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+}
+
+int SpatialGrid::CellCoord(float value) const {
+    return static_cast<int>(std::floor(value * inverseCellSize));
+}
+
+size_t SpatialGrid::Hash(int cellX, int cellY) const {
+    // Large primes spread neighboring cells across buckets; negative coordinates wrap harmlessly
+    uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return h & bucketMask;
+}
+
+void SpatialGrid::Build(const float* xs, const float* ys, size_t count) {
+    cellOfPoint.resize(count);
+    sortedIndices.resize(count);
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+
+    // Pass 1: count points per bucket
+    for (size_t i = 0; i < count; ++i) {
+        int bucket = static_cast<int>(Hash(CellCoord(xs[i]), CellCoord(ys[i])));
+        cellOfPoint[i] = bucket;
+        bucketStart[bucket + 1]++;
+    }
+
+    // Prefix sum turns counts into start offsets
+    for (size_t b = 1; b < bucketStart.size(); ++b) {
+        bucketStart[b] += bucketStart[b - 1];
+    }
+
+    // Pass 2: scatter indices into their bucket ranges. bucketStart[b] is used as a write
+    // cursor and ends up pointing at the start of bucket b + 1, so shift it back afterwards.
+    for (size_t i = 0; i < count; ++i) {
+        sortedIndices[bucketStart[cellOfPoint[i]]++] = static_cast<int>(i);
+    }
+    for (size_t b = bucketStart.size() - 1; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+void SpatialGrid::Reserve(size_t count) {
+    cellOfPoint.reserve(count);
+    sortedIndices.reserve(count);
+}
+
+void SpatialGrid::Query(float x, float y, float radius, std::vector<int>& out) const {
+    size_t visited[MAX_TRACKED];
+    int visitedCount = 0;
+    AppendBlock(CellCoord(x - radius), CellCoord(y - radius), CellCoord(x + radius), CellCoord(y + radius),
+                visited, visitedCount, out);
+}
+
+void SpatialGrid::QuerySegment(float x0, float y0, float x1, float y1, float radius, std::vector<int>& out) const {
+    size_t visited[MAX_TRACKED];
+    int visitedCount = 0;
+
+    // A point within radius of the segment sits at most this many cells from a crossed cell
+    int reach = static_cast<int>(std::ceil(radius * inverseCellSize));
+    int cellX = CellCoord(x0);
+    int cellY = CellCoord(y0);
+    int endX = CellCoord(x1);
+    int endY = CellCoord(y1);
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    int stepX = (dx > 0.0f) - (dx < 0.0f);
+    int stepY = (dy > 0.0f) - (dy < 0.0f);
+    // Segment parameter at the next vertical/horizontal cell border, and between two borders
+    float nextX = stepX != 0 ? ((cellX + (stepX > 0)) * cellSize - x0) / dx : INFINITY;
+    float nextY = stepY != 0 ? ((cellY + (stepY > 0)) * cellSize - y0) / dy : INFINITY;
+    float deltaX = stepX != 0 ? cellSize / std::fabs(dx) : INFINITY;
+    float deltaY = stepY != 0 ? cellSize / std::fabs(dy) : INFINITY;
+
+    // Each step crosses exactly one border, so the walk is as long as the Manhattan distance in
+    // cells; the end checks keep rounding from stepping past the last cell on either axis
+    int steps = std::abs(endX - cellX) + std::abs(endY - cellY);
+    for (int step = 0; ; ++step) {
+        AppendBlock(cellX - reach, cellY - reach, cellX + reach, cellY + reach, visited, visitedCount, out);
+        if (step == steps) break;
+        if (cellY == endY || (cellX != endX && nextX < nextY)) {
+            cellX += stepX;
+            nextX += deltaX;
+        } else {
+            cellY += stepY;
+            nextY += deltaY;
+        }
+    }
+}
+
+void SpatialGrid::AppendBlock(int minX, int minY, int maxX, int maxY,
+                              size_t* visited, int& visitedCount, std::vector<int>& out) const {
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            size_t bucket = Hash(cx, cy);
+
+            bool seen = false;
+            for (int v = 0; v < visitedCount; ++v) {
+                if (visited[v] == bucket) {
+                    seen = true;
+                    break;
+                }
+            }
+            if (seen) continue;
+            if (visitedCount < MAX_TRACKED) {
+                visited[visitedCount++] = bucket;
+            }
+
+            for (int s = bucketStart[bucket]; s < bucketStart[bucket + 1]; ++s) {
+                out.push_back(sortedIndices[s]);
+            }
+        }
+    }
+}
@@ -0,0 +1,281 @@
+#include "include/SteeringKernels.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STEERING_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+void SteeringBatch::Resize(size_t lanes) {
+    if (slot.size() < lanes) {
+        slot.resize(lanes);
+        baseX.resize(lanes);
+        baseY.resize(lanes);
+        sepX.resize(lanes);
+        sepY.resize(lanes);
+        sepCount.resize(lanes);
+        aliX.resize(lanes);
+        aliY.resize(lanes);
+        aliCount.resize(lanes);
+        cohX.resize(lanes);
+        cohY.resize(lanes);
+        cohCount.resize(lanes);
+        posX.resize(lanes);
+        posY.resize(lanes);
+        speed.resize(lanes);
+    }
+    count = lanes;
+}
+
+void SteeringBatch::Reserve(size_t lanes) {
+    slot.reserve(lanes);
+    baseX.reserve(lanes);
+    baseY.reserve(lanes);
+    sepX.reserve(lanes);
+    sepY.reserve(lanes);
+    sepCount.reserve(lanes);
+    aliX.reserve(lanes);
+    aliY.reserve(lanes);
+    aliCount.reserve(lanes);
+    cohX.reserve(lanes);
+    cohY.reserve(lanes);
+    cohCount.reserve(lanes);
+    posX.reserve(lanes);
+    posY.reserve(lanes);
+    speed.reserve(lanes);
+}
+
+void SteeringBatch::SetIdle(size_t lane) {
+    slot[lane] = -1;
+    baseX[lane] = baseY[lane] = 0.0f;
+    sepX[lane] = sepY[lane] = sepCount[lane] = 0.0f;
+    aliX[lane] = aliY[lane] = aliCount[lane] = 0.0f;
+    cohX[lane] = cohY[lane] = cohCount[lane] = 0.0f;
+    posX[lane] = posY[lane] = 0.0f;
+    speed[lane] = 0.0f;
+}
+
+namespace SteeringKernels {
+
+namespace {
+    inline void Normalize(float& vx, float& vy) {
+        float length = std::sqrt(vx * vx + vy * vy);
+        if (length > 0) {
+            vx /= length;
+            vy /= length;
+        }
+    }
+
+    inline void CombineLane(SteeringBatch& b, size_t i, float deltaTime, const SteeringWeights& w) {
+        float sepX = 0, sepY = 0;
+        float aliX = 0, aliY = 0;
+        float cohX = 0, cohY = 0;
+
+        // Average the separation force
+        if (b.sepCount[i] > 0) {
+            sepX = b.sepX[i] / b.sepCount[i];
+            sepY = b.sepY[i] / b.sepCount[i];
+            Normalize(sepX, sepY);
+        }
+        // Calculate average direction
+        if (b.aliCount[i] > 0) {
+            aliX = b.aliX[i] / b.aliCount[i];
+            aliY = b.aliY[i] / b.aliCount[i];
+            Normalize(aliX, aliY);
+        }
+        // Find the direction to the center of mass
+        if (b.cohCount[i] > 0) {
+            cohX = b.cohX[i] / b.cohCount[i] - b.posX[i];
+            cohY = b.cohY[i] / b.cohCount[i] - b.posY[i];
+            Normalize(cohX, cohY);
+        }
+
+        float dx = b.baseX[i] * w.player + sepX * w.separation + aliX * w.alignment + cohX * w.cohesion;
+        float dy = b.baseY[i] * w.player + sepY * w.separation + aliY * w.alignment + cohY * w.cohesion;
+        Normalize(dx, dy);
+
+        b.posX[i] += dx * b.speed[i] * deltaTime;
+        b.posY[i] += dy * b.speed[i] * deltaTime;
+    }
+}
+
+void CombineScalar(SteeringBatch& batch, size_t begin, size_t end,
+                   float deltaTime, const SteeringWeights& weights) {
+    for (size_t i = begin; i < end; ++i) {
+        CombineLane(batch, i, deltaTime, weights);
+    }
+}
+
+#ifdef STEERING_SIMD_X86
+
+namespace {
+    // --- SSE2: 4 zombies per instruction ---
+
+    __attribute__((target("sse2"))) inline __m128 Select4(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    __attribute__((target("sse2"))) inline void Normalize4(__m128& vx, __m128& vy) {
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        __m128 nonZero = _mm_cmpgt_ps(length, _mm_setzero_ps());
+        vx = Select4(nonZero, _mm_div_ps(vx, length), vx);
+        vy = Select4(nonZero, _mm_div_ps(vy, length), vy);
+    }
+
+    // Average of a sum over count, or zero where count is zero. offset is subtracted before masking.
+    __attribute__((target("sse2"))) inline void Average4(const float* sumX, const float* sumY, const float* count,
+                                                         __m128 offsetX, __m128 offsetY, __m128& outX, __m128& outY) {
+        __m128 n = _mm_loadu_ps(count);
+        __m128 has = _mm_cmpgt_ps(n, _mm_setzero_ps());
+        __m128 divisor = _mm_max_ps(n, _mm_set1_ps(1.0f));
+        outX = _mm_sub_ps(_mm_div_ps(_mm_loadu_ps(sumX), divisor), offsetX);
+        outY = _mm_sub_ps(_mm_div_ps(_mm_loadu_ps(sumY), divisor), offsetY);
+        Normalize4(outX, outY);
+        outX = _mm_and_ps(has, outX);
+        outY = _mm_and_ps(has, outY);
+    }
+
+    __attribute__((target("sse2")))
+    void CombineSSE2(SteeringBatch& b, size_t begin, size_t end, float deltaTime, const SteeringWeights& w) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 wPlayer = _mm_set1_ps(w.player);
+        const __m128 wSep = _mm_set1_ps(w.separation);
+        const __m128 wAli = _mm_set1_ps(w.alignment);
+        const __m128 wCoh = _mm_set1_ps(w.cohesion);
+        const __m128 dt = _mm_set1_ps(deltaTime);
+
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            __m128 posX = _mm_loadu_ps(&b.posX[i]);
+            __m128 posY = _mm_loadu_ps(&b.posY[i]);
+
+            __m128 sepX, sepY, aliX, aliY, cohX, cohY;
+            Average4(&b.sepX[i], &b.sepY[i], &b.sepCount[i], zero, zero, sepX, sepY);
+            Average4(&b.aliX[i], &b.aliY[i], &b.aliCount[i], zero, zero, aliX, aliY);
+            Average4(&b.cohX[i], &b.cohY[i], &b.cohCount[i], posX, posY, cohX, cohY);
+
+            // Same left-to-right order as the scalar sum
+            __m128 dx = _mm_mul_ps(_mm_loadu_ps(&b.baseX[i]), wPlayer);
+            dx = _mm_add_ps(dx, _mm_mul_ps(sepX, wSep));
+            dx = _mm_add_ps(dx, _mm_mul_ps(aliX, wAli));
+            dx = _mm_add_ps(dx, _mm_mul_ps(cohX, wCoh));
+            __m128 dy = _mm_mul_ps(_mm_loadu_ps(&b.baseY[i]), wPlayer);
+            dy = _mm_add_ps(dy, _mm_mul_ps(sepY, wSep));
+            dy = _mm_add_ps(dy, _mm_mul_ps(aliY, wAli));
+            dy = _mm_add_ps(dy, _mm_mul_ps(cohY, wCoh));
+            Normalize4(dx, dy);
+
+            __m128 speed = _mm_loadu_ps(&b.speed[i]);
+            _mm_storeu_ps(&b.posX[i], _mm_add_ps(posX, _mm_mul_ps(_mm_mul_ps(dx, speed), dt)));
+            _mm_storeu_ps(&b.posY[i], _mm_add_ps(posY, _mm_mul_ps(_mm_mul_ps(dy, speed), dt)));
+        }
+        CombineScalar(b, i, end, deltaTime, w); // Leftover lanes
+    }
+
+    // --- AVX2: 8 zombies per instruction ---
+
+    __attribute__((target("avx2"))) inline void Normalize8(__m256& vx, __m256& vy) {
+        __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+        __m256 nonZero = _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ);
+        vx = _mm256_blendv_ps(vx, _mm256_div_ps(vx, length), nonZero);
+        vy = _mm256_blendv_ps(vy, _mm256_div_ps(vy, length), nonZero);
+    }
+
+    __attribute__((target("avx2"))) inline void Average8(const float* sumX, const float* sumY, const float* count,
+                                                         __m256 offsetX, __m256 offsetY, __m256& outX, __m256& outY) {
+        __m256 n = _mm256_loadu_ps(count);
+        __m256 has = _mm256_cmp_ps(n, _mm256_setzero_ps(), _CMP_GT_OQ);
+        __m256 divisor = _mm256_max_ps(n, _mm256_set1_ps(1.0f));
+        outX = _mm256_sub_ps(_mm256_div_ps(_mm256_loadu_ps(sumX), divisor), offsetX);
+        outY = _mm256_sub_ps(_mm256_div_ps(_mm256_loadu_ps(sumY), divisor), offsetY);
+        Normalize8(outX, outY);
+        outX = _mm256_and_ps(has, outX);
+        outY = _mm256_and_ps(has, outY);
+    }
+
+    __attribute__((target("avx2")))
+    void CombineAVX2(SteeringBatch& b, size_t begin, size_t end, float deltaTime, const SteeringWeights& w) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 wPlayer = _mm256_set1_ps(w.player);
+        const __m256 wSep = _mm256_set1_ps(w.separation);
+        const __m256 wAli = _mm256_set1_ps(w.alignment);
+        const __m256 wCoh = _mm256_set1_ps(w.cohesion);
+        const __m256 dt = _mm256_set1_ps(deltaTime);
+
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            __m256 posX = _mm256_loadu_ps(&b.posX[i]);
+            __m256 posY = _mm256_loadu_ps(&b.posY[i]);
+
+            __m256 sepX, sepY, aliX, aliY, cohX, cohY;
+            Average8(&b.sepX[i], &b.sepY[i], &b.sepCount[i], zero, zero, sepX, sepY);
+            Average8(&b.aliX[i], &b.aliY[i], &b.aliCount[i], zero, zero, aliX, aliY);
+            Average8(&b.cohX[i], &b.cohY[i], &b.cohCount[i], posX, posY, cohX, cohY);
+
+            __m256 dx = _mm256_mul_ps(_mm256_loadu_ps(&b.baseX[i]), wPlayer);
+            dx = _mm256_add_ps(dx, _mm256_mul_ps(sepX, wSep));
+            dx = _mm256_add_ps(dx, _mm256_mul_ps(aliX, wAli));
+            dx = _mm256_add_ps(dx, _mm256_mul_ps(cohX, wCoh));
+            __m256 dy = _mm256_mul_ps(_mm256_loadu_ps(&b.baseY[i]), wPlayer);
+            dy = _mm256_add_ps(dy, _mm256_mul_ps(sepY, wSep));
+            dy = _mm256_add_ps(dy, _mm256_mul_ps(aliY, wAli));
+            dy = _mm256_add_ps(dy, _mm256_mul_ps(cohY, wCoh));
+            Normalize8(dx, dy);
+
+            __m256 speed = _mm256_loadu_ps(&b.speed[i]);
+            _mm256_storeu_ps(&b.posX[i], _mm256_add_ps(posX, _mm256_mul_ps(_mm256_mul_ps(dx, speed), dt)));
+            _mm256_storeu_ps(&b.posY[i], _mm256_add_ps(posY, _mm256_mul_ps(_mm256_mul_ps(dy, speed), dt)));
+        }
+        CombineSSE2(b, i, end, deltaTime, w); // Leftover lanes, 4 then 1 at a time
+    }
+}
+
+#endif // STEERING_SIMD_X86
+
+namespace {
+    const char* selectedName = "scalar";
+
+    CombineFunc Detect() {
+        // Best first; SIMD kernels are checked against the scalar one by tests/steeringkernels_test
+        const char* const preferred[] = {"AVX2", "SSE2"};
+        for (const char* name : preferred) {
+            if (CombineFunc kernel = Find(name)) {
+                selectedName = name;
+                return kernel;
+            }
+        }
+        selectedName = "scalar";
+        return CombineScalar;
+    }
+}
+
+CombineFunc Find(const char* name) {
+    std::string wanted = name;
+    if (wanted == "scalar") {
+        return CombineScalar;
+    }
+#ifdef STEERING_SIMD_X86
+    __builtin_cpu_init();
+    if (wanted == "AVX2" && __builtin_cpu_supports("avx2")) {
+        return CombineAVX2;
+    }
+    if (wanted == "SSE2" && __builtin_cpu_supports("sse2")) {
+        return CombineSSE2;
+    }
+#endif
+    return nullptr;
+}
+
+CombineFunc Select() {
+    static const CombineFunc selected = Detect();
+    return selected;
+}
+
+const char* GetSelectedName() {
+    Select();
+    return selectedName;
+}
+
+} // namespace SteeringKernels
@@ -8,11 +8,19 @@
 #include <algorithm> // For std::max, std::min
 
 TileMap::TileMap(SDL_Renderer* renderer)
-    : renderer(renderer), tileset(nullptr), tileWidth(32), tileHeight(32), 
+    : renderer(renderer), tileset(nullptr), decodedTileset(nullptr), tileWidth(32), tileHeight(32), 
       mapWidth(0), mapHeight(0), tilesetCols(0) {
+    for (int i = 0; i < LOD_LEVELS; ++i) {
+        lodTextures[i] = nullptr;
+    }
 }
 
 TileMap::~TileMap() {
+    ReleaseLods(-1);
+    if (decodedTileset) {
+        SDL_FreeSurface(decodedTileset);
+        decodedTileset = nullptr;
+    }
     if (tileset) {
         SDL_DestroyTexture(tileset);
         tileset = nullptr;
@@ -20,9 +28,13 @@ TileMap::~TileMap() {
 }
 
 bool TileMap::LoadTileset(const char* path) {
-    if (tileset) {
-        SDL_DestroyTexture(tileset);
-        tileset = nullptr;
+    return DecodeTileset(path) && UploadTileset();
+}
+
+bool TileMap::DecodeTileset(const char* path) {
+    if (decodedTileset) {
+        SDL_FreeSurface(decodedTileset);
+        decodedTileset = nullptr;
     }
 
     SDL_Surface* surface = IMG_Load(path);
@@ -31,17 +43,28 @@ bool TileMap::LoadTileset(const char* path) {
         return false;
     }
 
-    tileset = SDL_CreateTextureFromSurface(renderer, surface);
+    // Calculate number of columns in the tileset
+    tilesetCols = surface->w / tileWidth;
+    decodedTileset = surface;
+    return true;
+}
+
+bool TileMap::UploadTileset() {
+    if (!decodedTileset) return tileset != nullptr;
+
+    if (tileset) {
+        SDL_DestroyTexture(tileset);
+        tileset = nullptr;
+    }
+    ReleaseLods(-1);
+
+    tileset = SDL_CreateTextureFromSurface(renderer, decodedTileset);
+    SDL_FreeSurface(decodedTileset);
+    decodedTileset = nullptr;
     if (!tileset) {
         std::cerr << "Failed to create tileset texture: " << SDL_GetError() << std::endl;
-        SDL_FreeSurface(surface);
         return false;
     }
-
-    // Calculate number of columns in the tileset
-    tilesetCols = surface->w / tileWidth;
-    
-    SDL_FreeSurface(surface);
     return true;
 }
 
@@ -52,34 +75,44 @@ bool TileMap::ParseCSV(const char* path) {
         return false;
     }
 
-    map.clear();
+    auto layer = std::make_shared<TileLayer>();
     std::string line;
     while (std::getline(file, line)) {
-        std::vector<int> row;
         std::stringstream ss(line);
         std::string cell;
+        int rowWidth = 0;
 
         while (std::getline(ss, cell, ',')) {
+            int tileId;
             try {
-                row.push_back(std::stoi(cell));
+                tileId = std::stoi(cell);
             } catch (const std::exception& e) {
                 std::cerr << "Error parsing tile ID: " << cell << std::endl;
                 return false;
             }
+            if (tileId >= TileLayer::EMPTY) {
+                std::cerr << "Tile ID out of range: " << tileId << std::endl;
+                return false;
+            }
+            layer->tiles.push_back(tileId < 0 ? TileLayer::EMPTY : static_cast<uint16_t>(tileId));
+            rowWidth++;
         }
 
-        if (row.size() > 0) {
-            if (mapWidth == 0) {
-                mapWidth = row.size();
-            } else if (mapWidth != row.size()) {
+        if (rowWidth > 0) {
+            if (layer->width == 0) {
+                layer->width = rowWidth;
+            } else if (layer->width != rowWidth) {
                 std::cerr << "Inconsistent map width in CSV file" << std::endl;
                 return false;
             }
-            map.push_back(row);
+            layer->height++;
         }
     }
 
-    mapHeight = map.size();
+    map = layer;
+    mapWidth = layer->width;
+    mapHeight = layer->height;
+    ReleaseLods(-1);
     return true;
 }
 
@@ -87,15 +120,54 @@ bool TileMap::LoadMap(const char* path) {
     return ParseCSV(path);
 }
 
+void TileMap::ShareMap(const TileMap& source) {
+    map = source.map;
+    mapWidth = source.mapWidth;
+    mapHeight = source.mapHeight;
+    tileWidth = source.tileWidth;
+    tileHeight = source.tileHeight;
+    ReleaseLods(-1);
+}
+
+int TileMap::GetTile(int column, int row) const {
+    if (!map || row < 0 || row >= mapHeight || column < 0 || column >= mapWidth) return -1;
+    uint16_t tile = map->At(column, row);
+    return tile == TileLayer::EMPTY ? -1 : tile;
+}
+
+void TileMap::SetTile(int column, int row, int tileId) {
+    if (!map || row < 0 || row >= mapHeight || column < 0 || column >= mapWidth) return;
+    if (tileId >= TileLayer::EMPTY) {
+        std::cerr << "Tile ID out of range: " << tileId << std::endl;
+        return;
+    }
+    uint16_t tile = tileId < 0 ? TileLayer::EMPTY : static_cast<uint16_t>(tileId);
+    if (map->At(column, row) == tile) return;
+
+    if (map.use_count() > 1) {
+        map = std::make_shared<TileLayer>(*map); // Other chunks keep the original
+    }
+    map->tiles[static_cast<size_t>(row) * mapWidth + column] = tile;
+    ReleaseLods(-1); // Baked levels show the old tile
+}
+
+bool TileMap::IsBlockedAt(float localX, float localY) const {
+    if (!map || tileWidth == 0 || tileHeight == 0) return false;
+    int column = static_cast<int>(std::floor(localX / tileWidth));
+    int row = static_cast<int>(std::floor(localY / tileHeight));
+    if (row < 0 || row >= mapHeight || column < 0 || column >= mapWidth) return false;
+    return map->At(column, row) == TileLayer::EMPTY;
+}
+
 // MODIFIED: Added worldOffsetX and worldOffsetY parameters
 void TileMap::Render(Camera* camera, int worldOffsetX, int worldOffsetY) { 
-    if (!tileset || map.empty() || !camera || tileWidth == 0 || tileHeight == 0) return;
+    if (!tileset || !map || !camera || tileWidth == 0 || tileHeight == 0) return;
 // Camera's X and Y are absolute world coordinates
     float camX = camera->GetX(); 
     float camY = camera->GetY();
 // Get camera's view dimensions
-    int camViewWidth = camera->GetViewWidth();
-    int camViewHeight = camera->GetViewHeight();
+    float camViewWidth = camera->GetWorldViewWidth();
+    float camViewHeight = camera->GetWorldViewHeight();
 
     // Determine the range of tiles to render based on camera and this chunk's world offset
     // The camera's X and Y are absolute world coordinates.
@@ -123,10 +195,13 @@ void TileMap::Render(Camera* camera, int worldOffsetX, int worldOffsetY) {
     int clampedStartRow = std::max(0, startRow);
     int clampedEndRow = std::min(mapHeight, endRow);
 
+    // Each visible row is one contiguous run of the flat layer
+    const uint16_t* tiles = map->tiles.data();
     for (int row = clampedStartRow; row < clampedEndRow; ++row) {
+        const uint16_t* rowTiles = tiles + static_cast<size_t>(row) * mapWidth;
         for (int column = clampedStartCol; column < clampedEndCol; ++column) {
-            int tileId = map[row][column];
-            if (tileId < 0) continue; // Skip empty tiles (-1 or other invalid)
+            uint16_t tileId = rowTiles[column];
+            if (tileId == TileLayer::EMPTY) continue; // Skip empty tiles
 
             SDL_Rect srcRect;
             srcRect.x = (tileId % tilesetCols) * tileWidth;
@@ -146,4 +221,86 @@ void TileMap::Render(Camera* camera, int worldOffsetX, int worldOffsetY) {
             SDL_RenderCopy(renderer, tileset, &srcRect, &dstRect);
         }
     }
-}
\ No newline at end of file
+}
+
+void TileMap::ReleaseLods(int keepLevel) {
+    for (int i = 0; i < LOD_LEVELS; ++i) {
+        if (i != keepLevel && lodTextures[i]) {
+            SDL_DestroyTexture(lodTextures[i]);
+            lodTextures[i] = nullptr;
+        }
+    }
+}
+
+SDL_Texture* TileMap::BakeLod(int level) {
+    int width = std::max(1, GetPixelWidth() >> level);
+    int height = std::max(1, GetPixelHeight() >> level);
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        std::cerr << "Failed to create chunk LOD texture: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+
+    // Each level is a 2x downsample of the one above it (a mip chain)
+    SDL_Texture* source = (level > 1) ? GetLodTexture(level - 1) : nullptr;
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    if (source) {
+        SDL_RenderCopy(renderer, source, nullptr, nullptr);
+    } else {
+        // First level comes straight from the tiles, filtered on the way down
+        SDL_ScaleMode previousScaleMode = SDL_ScaleModeNearest;
+        SDL_GetTextureScaleMode(tileset, &previousScaleMode);
+        SDL_SetTextureScaleMode(tileset, SDL_ScaleModeLinear);
+        int lodTileWidth = std::max(1, tileWidth >> level);
+        int lodTileHeight = std::max(1, tileHeight >> level);
+        for (int row = 0; row < mapHeight; ++row) {
+            for (int column = 0; column < mapWidth; ++column) {
+                uint16_t tileId = map->At(column, row);
+                if (tileId == TileLayer::EMPTY) continue;
+
+                SDL_Rect srcRect = {(tileId % tilesetCols) * tileWidth, (tileId / tilesetCols) * tileHeight, tileWidth, tileHeight};
+                SDL_Rect dstRect = {column * lodTileWidth, row * lodTileHeight, lodTileWidth, lodTileHeight};
+                SDL_RenderCopy(renderer, tileset, &srcRect, &dstRect);
+            }
+        }
+        SDL_SetTextureScaleMode(tileset, previousScaleMode);
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    return texture;
+}
+
+SDL_Texture* TileMap::GetLodTexture(int level) {
+    if (level <= 0 || level >= LOD_LEVELS || !tileset || !map) return nullptr;
+    if (!lodTextures[level]) {
+        lodTextures[level] = BakeLod(level);
+        // Only the level in use stays resident; the finer ones were just intermediates
+        ReleaseLods(level);
+    }
+    return lodTextures[level];
+}
+
+void TileMap::RenderLod(Camera* camera, int worldOffsetX, int worldOffsetY, int level) {
+    if (!camera) return;
+
+    SDL_Texture* texture = GetLodTexture(level);
+    if (!texture) {
+        Render(camera, worldOffsetX, worldOffsetY); // Bake failed, fall back to per-tile drawing
+        return;
+    }
+
+    // Destination is in world units; the renderer scale maps it back to the baked resolution
+    SDL_Rect dstRect = {
+        static_cast<int>(std::round(worldOffsetX - camera->GetX())),
+        static_cast<int>(std::round(worldOffsetY - camera->GetY())),
+        GetPixelWidth(),
+        GetPixelHeight()
+    };
+    SDL_RenderCopy(renderer, texture, nullptr, &dstRect);
+}
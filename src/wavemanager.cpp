@@ -1,4 +1,5 @@
 #include "include/WaveManager.h"
+#include "include/Simulation.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -16,7 +17,8 @@ WaveManager::WaveManager()
       newWeaponUnlocked(false),                            // No weapons unlocked initially
       zombiesInCurrentGroup(0),                            // No zombies in current group
       currentGroupSize(0),                                 // No group size initially
-      lastTimerUpdate(0) {}                                // Track last timer update
+      lastTimerUpdate(0),                                  // Track last timer update
+      random(nullptr) {}
 
 
 void WaveManager::StartNextWave() {
@@ -137,8 +139,8 @@ int WaveManager::GetRandomGroupSize() const {
     }
     
     // Random group size between min and max
-    // Use rand() to get a random number in the range [minPossible, maxPossible]
-    return minPossible + (rand() % (maxPossible - minPossible + 1));
+    if (!random) return minPossible;
+    return random->RangeInt(minPossible, maxPossible);
 }
 
 
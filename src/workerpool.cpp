@@ -0,0 +1,87 @@
+#include "include/WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned threadCount)
+    : job(nullptr), jobContext(nullptr), jobCount(0), jobGrain(1), nextChunk(0), generation(0), busyWorkers(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // The calling thread does its share, so spawn one fewer
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&WorkerPool::WorkerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::RunChunks(unsigned worker) {
+    while (true) {
+        size_t begin = nextChunk.fetch_add(jobGrain);
+        if (begin >= jobCount) break;
+        size_t end = std::min(begin + jobGrain, jobCount);
+        job(jobContext, begin, end, worker);
+    }
+}
+
+void WorkerPool::WorkerLoop(unsigned worker) {
+    unsigned seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        RunChunks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) {
+                doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void WorkerPool::Run(size_t count, size_t grain, RangeThunk thunk, const void* context) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+
+    // Not worth waking anyone for a single chunk
+    if (workers.empty() || count <= grain) {
+        thunk(context, 0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = thunk;
+        jobContext = context;
+        jobCount = count;
+        jobGrain = grain;
+        nextChunk.store(0);
+        busyWorkers = static_cast<unsigned>(workers.size());
+        ++generation;
+    }
+    wakeCondition.notify_all();
+
+    RunChunks(0);
+
+    // Every worker checks in before the job (and the caller's func) can go away
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [&]() { return busyWorkers == 0; });
+    job = nullptr;
+    jobContext = nullptr;
+}
@@ -1,38 +1,34 @@
 #include "include/Zombie.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 
-Zombie::Zombie(SDL_Renderer* renderer, float startX, float startY) 
-    : renderer(renderer), x(startX), y(startY), rotation(0.0f),
-      health(STARTING_HEALTH), isDead(false), speed(100.0f), isAttacking(false), lastAttackTime(0),
-      showDebugHitbox(false), currentFrame(0), frameTimer(0.0f), frameDuration(DEFAULT_FRAME_DURATION),
-      knockbackVelocityX(0.0f), knockbackVelocityY(0.0f), knockbackDuration(0.0f) {
-    
-    // Initialize hitbox
-    hitbox.w = 50;  // width of zombie
-    hitbox.h = 50;  // height of zombie
-    hitbox.x = static_cast<int>(x - hitbox.w / 2);
-    hitbox.y = static_cast<int>(y - hitbox.h / 2);
-
-    LoadTextures();
-}
-
-Zombie::~Zombie() {
-    // Cleanup animation textures
-    for (SDL_Texture* tex : moveFrames) {
-        if (tex) SDL_DestroyTexture(tex);
-    }
-    for (SDL_Texture* tex : attackFrames) {
-        if (tex) SDL_DestroyTexture(tex);
-    }
-}
+void ZombieAssets::Load(SDL_Renderer* renderer) {
+    auto loadAnimationSet = [renderer](std::vector<SDL_Texture*>& frames, const std::string& basePath,
+                                       const std::string& prefix, int frameCount) {
+        frames.clear();
+        for (int i = 0; i < frameCount; ++i) {
+            std::string path = basePath + prefix + std::to_string(i) + ".png";
+            SDL_Surface* surface = IMG_Load(path.c_str());
+            if (!surface) {
+                std::cerr << "Failed to load zombie texture: " << path << " Error: " << IMG_GetError() << std::endl;
+                continue;
+            }
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+            SDL_FreeSurface(surface);
+            if (!texture) {
+                std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
+                continue;
+            }
+            frames.push_back(texture);
+        }
+    };
 
-void Zombie::LoadTextures() {
     // Load move animation
-    LoadAnimationSet(moveFrames, "assets/zombie/move/", "zombie_move_", MOVE_FRAME_COUNT);
+    loadAnimationSet(moveFrames, "assets/zombie/move/", "zombie_move_", MOVE_FRAME_COUNT);
     // Load attack animation
-    LoadAnimationSet(attackFrames, "assets/zombie/attack/", "zombie_attack_", ATTACK_FRAME_COUNT);
+    loadAnimationSet(attackFrames, "assets/zombie/attack/", "zombie_attack_", ATTACK_FRAME_COUNT);
 
     // Set up source and destination rectangles
     if (!moveFrames.empty() && moveFrames[0]) {
@@ -42,43 +38,114 @@ void Zombie::LoadTextures() {
         
         // Scale the sprite to match player size (approximately 64x64)
         float scale = 0.5f;  // Adjust this to match player size
-        destRect.w = static_cast<int>(srcRect.w * scale);
-        destRect.h = static_cast<int>(srcRect.h * scale);
+        destWidth = static_cast<int>(srcRect.w * scale);
+        destHeight = static_cast<int>(srcRect.h * scale);
         
         // Update hitbox to match the sprite size
-        hitbox.w = static_cast<int>(destRect.w * 0.6f);  // Make hitbox slightly smaller than sprite
-        hitbox.h = static_cast<int>(destRect.h * 0.6f);
+        hitboxWidth = static_cast<int>(destWidth * 0.6f);  // Make hitbox slightly smaller than sprite
+        hitboxHeight = static_cast<int>(destHeight * 0.6f);
     }
 }
 
-void Zombie::LoadAnimationSet(std::vector<SDL_Texture*>& frames, const std::string& basePath, 
-                            const std::string& prefix, int frameCount) {
-    frames.clear();
-    for (int i = 0; i < frameCount; ++i) {
-        std::string path = basePath + prefix + std::to_string(i) + ".png";
-        SDL_Surface* surface = IMG_Load(path.c_str());
-        if (!surface) {
-            std::cerr << "Failed to load zombie texture: " << path << " Error: " << IMG_GetError() << std::endl;
-            continue;
-        }
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!texture) {
-            std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
-            continue;
-        }
-        frames.push_back(texture);
+void ZombieAssets::Free() {
+    // Cleanup animation textures
+    for (SDL_Texture* tex : moveFrames) {
+        if (tex) SDL_DestroyTexture(tex);
     }
+    for (SDL_Texture* tex : attackFrames) {
+        if (tex) SDL_DestroyTexture(tex);
+    }
+    moveFrames.clear();
+    attackFrames.clear();
+}
+
+void ZombieStore::SnapshotPrevious() {
+    prevX = x;
+    prevY = y;
+    prevHitboxX = hitboxX;
+    prevHitboxY = hitboxY;
+    prevDead = dead;
+}
+
+void ZombieStore::Reserve(size_t capacity) {
+    x.reserve(capacity);
+    y.reserve(capacity);
+    hitboxX.reserve(capacity);
+    hitboxY.reserve(capacity);
+    dead.reserve(capacity);
+    speed.reserve(capacity);
+    rotation.reserve(capacity);
+    knockbackVelocityX.reserve(capacity);
+    knockbackVelocityY.reserve(capacity);
+    knockbackDuration.reserve(capacity);
+    velocityX.reserve(capacity);
+    velocityY.reserve(capacity);
+    health.reserve(capacity);
+    attacking.reserve(capacity);
+    lastAttackTime.reserve(capacity);
+    currentFrame.reserve(capacity);
+    frameTimer.reserve(capacity);
+    generation.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    prevHitboxX.reserve(capacity);
+    prevHitboxY.reserve(capacity);
+    prevDead.reserve(capacity);
+}
+
+Zombie::Zombie(ZombieStore* store, const ZombieAssets* assets, float startX, float startY)
+    : store(store), assets(assets), slot(static_cast<int>(store->Size())) {
+    store->x.push_back(startX);
+    store->y.push_back(startY);
+    store->hitboxX.push_back(0);
+    store->hitboxY.push_back(0);
+    store->dead.push_back(0);
+    store->speed.push_back(100.0f);
+    store->rotation.push_back(0.0f);
+    store->knockbackVelocityX.push_back(0.0f);
+    store->knockbackVelocityY.push_back(0.0f);
+    store->knockbackDuration.push_back(0.0f);
+    store->velocityX.push_back(0.0f);
+    store->velocityY.push_back(0.0f);
+    store->health.push_back(STARTING_HEALTH);
+    store->attacking.push_back(0);
+    store->lastAttackTime.push_back(0);
+    store->currentFrame.push_back(0);
+    store->frameTimer.push_back(0.0f);
+    store->generation.push_back(1);     // Never matches a default (null) handle's 0
+
+    SyncHitbox();
+}
+
+void Zombie::SyncHitbox() {
+    // Keep the hitbox centered on the zombie
+    store->hitboxX[slot] = static_cast<int>(store->x[slot] - assets->hitboxWidth / 2);
+    store->hitboxY[slot] = static_cast<int>(store->y[slot] - assets->hitboxHeight / 2);
+}
+
+void Zombie::Coast(float deltaTime) {
+    store->x[slot] += store->velocityX[slot] * deltaTime;
+    store->y[slot] += store->velocityY[slot] * deltaTime;
+    SyncHitbox();
+}
+
+void Zombie::MoveTo(float newX, float newY) {
+    store->x[slot] = newX;
+    store->y[slot] = newY;
+    SyncHitbox();
 }
 
 void Zombie::UpdateAnimation(float deltaTime) {
+    float& frameTimer = store->frameTimer[slot];
+    int& currentFrame = store->currentFrame[slot];
+    bool isAttacking = store->attacking[slot] != 0;
+
     frameTimer += deltaTime;
-    if (frameTimer >= frameDuration) {
+    if (frameTimer >= DEFAULT_FRAME_DURATION) {
         frameTimer = 0;
         currentFrame++;
         
-        const auto& currentFrames = isAttacking ? attackFrames : moveFrames;
-        int maxFrames = isAttacking ? ATTACK_FRAME_COUNT : MOVE_FRAME_COUNT;
+        int maxFrames = isAttacking ? ZombieAssets::ATTACK_FRAME_COUNT : ZombieAssets::MOVE_FRAME_COUNT;
         
         if (currentFrame >= maxFrames) {
             currentFrame = 0;
@@ -86,8 +153,17 @@ void Zombie::UpdateAnimation(float deltaTime) {
     }
 }
 
-void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>& zombies) {
-    if (isDead) return;
+bool Zombie::PrepareSteering(float deltaTime, Player* player, const FormationStats& formation,
+                             const FlowField* flowField, const std::vector<int>& neighbors,
+                             SteeringBatch& batch, size_t lane) {
+    if (IsDead()) return false;
+
+    // Work on this slot's fields in place
+    float& x = store->x[slot];
+    float& y = store->y[slot];
+    float& knockbackVelocityX = store->knockbackVelocityX[slot];
+    float& knockbackVelocityY = store->knockbackVelocityY[slot];
+    float& knockbackDuration = store->knockbackDuration[slot];
 
     // Handle knockback effect
     if (knockbackDuration > 0) {
@@ -96,8 +172,7 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
         knockbackDuration -= deltaTime;
         
         // Update hitbox during knockback
-        hitbox.x = static_cast<int>(x - hitbox.w / 2);
-        hitbox.y = static_cast<int>(y - hitbox.h / 2);
+        SyncHitbox();
         
         // If knockback is done, reset velocities
         if (knockbackDuration <= 0) {
@@ -107,7 +182,7 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
         
         // Still update animation even during knockback
         UpdateAnimation(deltaTime);
-        return;  // Skip normal movement while being knocked back
+        return false;  // Skip normal movement while being knocked back
     }
 
     // Get player position and calculate direction
@@ -119,7 +194,13 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
     /*create directional vector*/
 
     // Calculate rotation to face the player
-    rotation = (atan2(dy, dx) * 180.0f / M_PI);  // Remove the +90 if zombie sprite faces right by default
+    store->rotation[slot] = (atan2(dy, dx) * 180.0f / M_PI);  // Remove the +90 if zombie sprite faces right by default
+
+    // One pass over the grid neighbors gathers the flocking sums; formation spacing comes from
+    // the pool's per-tick ring statistics instead of a scan over every zombie
+    bool inFormationBand = distanceToPlayer >= CLOSE_RANGE && distanceToPlayer < FORMATION_RANGE;
+    SteeringSums sums;
+    AccumulateSteering(neighbors, sums);
 
     // Calculate base direction based on priority and formation
     if (distanceToPlayer < CLOSE_RANGE) {
@@ -128,29 +209,10 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
             dx /= distanceToPlayer;
             dy /= distanceToPlayer;
         }
-    } else if (distanceToPlayer < FORMATION_RANGE) {
+    } else if (inFormationBand) {
         // Tầm đội hình: Cố gắng tạo thành vòng tròn xung quanh người chơi
-        float angleToPlayer = std::atan2(dy, dx);
-        float desiredAngle = angleToPlayer;
-        
         // Tìm khoảng trống trong đội hình
-        int zombieCount = 0;
-        float angleSum = 0;
-        for (auto other : zombies) {
-            if (other != this && !other->isDead) {
-                float otherDx = other->GetX() - playerX;
-                float otherDy = other->GetY() - playerY;
-                float otherAngle = std::atan2(otherDy, otherDx);
-                angleSum += otherAngle;
-                zombieCount++;
-            }
-        }
-
-        if (zombieCount > 0) {
-            // Cố gắng phân bố zombie đều xung quanh vòng tròn
-            float averageAngle = angleSum / zombieCount;
-            desiredAngle = averageAngle + (2 * M_PI / (zombieCount + 1));
-        }
+        float desiredAngle = ChooseFormationAngle(formation, std::atan2(-dy, -dx));
 
         // Tính toán vị trí mong muốn trên vòng tròn
         float targetX = playerX + FORMATION_RADIUS * std::cos(desiredAngle);
@@ -165,62 +227,56 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
             dy /= formationDist;
         }
     } else {
-        // Ngoài tầm đội hình: Hành vi đuổi theo tiêu chuẩn
-        if (distanceToPlayer > 0) {
+        // Ngoài tầm đội hình: Hành vi đuổi theo tiêu chuẩn.
+        // The flow field only answers when something is in the way; otherwise chase in a straight line.
+        float pathX, pathY;
+        if (flowField && flowField->Sample(x, y, pathX, pathY)) {
+            dx = pathX;
+            dy = pathY;
+        } else if (distanceToPlayer > 0) {
             dx /= distanceToPlayer;
             dy /= distanceToPlayer;
         }
     }
 
-    // Áp dụng hành vi đàn đông với trọng số thích hợp
-    ApplyFlockingBehavior(zombies, dx, dy);
-
-    // Chuẩn hóa hướng di chuyển cuối cùng
-    float finalLength = std::sqrt(dx * dx + dy * dy);
-    if (finalLength > 0) {
-        dx /= finalLength;
-        dy /= finalLength;
-    }
+    // Áp dụng hành vi đàn đông với trọng số thích hợp: the weighting, normalization and
+    // movement run batched over all steering zombies (see SteeringKernels)
+    batch.slot[lane] = slot;
+    batch.baseX[lane] = dx;
+    batch.baseY[lane] = dy;
+    batch.sepX[lane] = sums.sepX;
+    batch.sepY[lane] = sums.sepY;
+    batch.sepCount[lane] = static_cast<float>(sums.sepCount);
+    batch.aliX[lane] = sums.aliX;
+    batch.aliY[lane] = sums.aliY;
+    batch.aliCount[lane] = static_cast<float>(sums.aliCount);
+    batch.cohX[lane] = sums.cohX;
+    batch.cohY[lane] = sums.cohY;
+    batch.cohCount[lane] = static_cast<float>(sums.cohCount);
+    batch.posX[lane] = x;
+    batch.posY[lane] = y;
+    batch.speed[lane] = store->speed[slot];
+    return true;
+}
 
-    // Di chuyển đến mục tiêu
-    x += dx * speed * deltaTime;
-    y += dy * speed * deltaTime;
+bool Zombie::FinishUpdate(float deltaTime, Player* player, Uint32 currentTime) {
+    Uint8& isAttacking = store->attacking[slot];
+    Uint32& lastAttackTime = store->lastAttackTime[slot];
+    int& currentFrame = store->currentFrame[slot];
+    float& frameTimer = store->frameTimer[slot];
 
     // Update hitbox position to be centered on the zombie
-    hitbox.x = static_cast<int>(x - hitbox.w / 2);
-    hitbox.y = static_cast<int>(y - hitbox.h / 2);
+    SyncHitbox();
 
     // Update attack state
     bool wasAttacking = isAttacking;
+    bool landedHit = false;
+    // Zombies are kept out of the player by ZombiePool's crowd collision step
     if (CheckCollisionWithPlayer(player)) {
-        
-        float player_current_X = player->GetX();
-        float player_current_Y = player->GetY();
-
-        // Vector from player to zombie (this is the direction zombie should be pushed)
-        float push_vec_X = x - player_current_X;
-        float push_vec_Y = y - player_current_Y;
-
-        float distance_to_player_at_collision = std::sqrt(push_vec_X * push_vec_X + push_vec_Y * push_vec_Y);
-
-        if (distance_to_player_at_collision > 0.001f) { // Check to avoid division by zero
-            
-            float norm_push_X = push_vec_X / (distance_to_player_at_collision+1);
-            float norm_push_Y = push_vec_Y / (distance_to_player_at_collision+1); // Create dampening effect
-
-            // Apply pushback
-            x += norm_push_X * SEPARATION_WEIGHT ;
-            y += norm_push_Y * SEPARATION_WEIGHT;
-
-            // Update hitbox immediately after position change due to pushback
-            hitbox.x = static_cast<int>(x - hitbox.w / 2);
-            hitbox.y = static_cast<int>(y - hitbox.h / 2);
-        }
-        Uint32 currentTime = SDL_GetTicks();          
           if (currentTime - lastAttackTime >= ATTACK_COOLDOWN) {
-            isAttacking = true;
+            isAttacking = 1;
             lastAttackTime = currentTime;
-            player->TakeDamage(WaveConfig::ZOMBIE_BASE_DAMAGE);
+            landedHit = true;
             if (!wasAttacking) {
                 // Reset animation when starting to attack
                 currentFrame = 0;
@@ -230,7 +286,7 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
     } else {
         if (wasAttacking) {
             // Reset animation when stopping attack
-            isAttacking = false;
+            isAttacking = 0;
             currentFrame = 0;
             frameTimer = 0;
         }
@@ -238,15 +294,24 @@ void Zombie::Update(float deltaTime, Player* player, const std::vector<Zombie*>&
 
     // Update animation
     UpdateAnimation(deltaTime);
+    return landedHit;
 }
 
 void Zombie::Render(SDL_Renderer* renderer, Camera* camera) {
-    if (isDead) return;
+    if (IsDead()) return;
+
+    SDL_Rect hitbox = GetHitbox();
+    float x = store->x[slot];
+    float y = store->y[slot];
+    int currentFrame = store->currentFrame[slot];
+    int health = store->health[slot];
+    const SDL_Rect& srcRect = assets->srcRect;
+    SDL_Rect destRect = {0, 0, assets->destWidth, assets->destHeight};
 
     // Get current animation frame
-    const auto& currentFrames = isAttacking ? attackFrames : moveFrames;
+    const auto& currentFrames = store->attacking[slot] ? assets->attackFrames : assets->moveFrames;
     // Check if the current frame is valid and loaded correctly
-    if (currentFrames.empty() || currentFrame >= currentFrames.size() || !currentFrames[currentFrame]) {
+    if (currentFrames.empty() || currentFrame >= static_cast<int>(currentFrames.size()) || !currentFrames[currentFrame]) {
         // Fallback rendering if textures aren't loaded
         SDL_Rect screenRect = {
             static_cast<int>(hitbox.x - camera->GetX()),
@@ -261,13 +326,21 @@ void Zombie::Render(SDL_Renderer* renderer, Camera* camera) {
 
     // Update destination rectangle position for rendering
     destRect.x = static_cast<int>(x - destRect.w / 2 - camera->GetX());
-    destRect.y = static_cast<int>(y - destRect.h / 2 - camera->GetY());    // Render the current frame with rotation
+    destRect.y = static_cast<int>(y - destRect.h / 2 - camera->GetY());
+
+    // Skip zombies outside the (zoomed) view
+    if (destRect.x + destRect.w < 0 || destRect.x > camera->GetWorldViewWidth() ||
+        destRect.y + destRect.h < 0 || destRect.y > camera->GetWorldViewHeight()) {
+        return;
+    }
+
+    // Render the current frame with rotation
     SDL_Point center = { destRect.w / 2, destRect.h / 2 }; 
     SDL_RenderCopyEx(renderer, currentFrames[currentFrame], &srcRect, &destRect, 
-                     rotation, &center, SDL_FLIP_NONE);
+                     store->rotation[slot], &center, SDL_FLIP_NONE);
 
     // Render hitbox visualization if debug mode is enabled
-    if (showDebugHitbox) {
+    if (store->showDebugHitbox) {
         SDL_Rect hitboxScreen = {
             static_cast<int>(hitbox.x - camera->GetX()),
             static_cast<int>(hitbox.y - camera->GetY()),
@@ -279,6 +352,8 @@ void Zombie::Render(SDL_Renderer* renderer, Camera* camera) {
         SDL_RenderDrawRect(renderer, &hitboxScreen);
     }
     
+    if (camera->GetZoom() < HEALTH_BAR_MIN_ZOOM) return;
+
     // Draw hit points above the zombie
     SDL_Rect healthBar = {
         static_cast<int>(hitbox.x - camera->GetX()),
@@ -296,210 +371,172 @@ void Zombie::Render(SDL_Renderer* renderer, Camera* camera) {
     SDL_RenderFillRect(renderer, &healthBar);
 }
 
-bool Zombie::CheckCollisionWithBullet(Bullet* bullet) {
-    if (isDead) return false;
-    
-    SDL_Rect bulletHitbox = bullet->GetHitbox();
-    if (SDL_HasIntersection(&hitbox, &bulletHitbox)) {
-        // Calculate direction from bullet to zombie for knockback
-        float dx = x - bullet->GetX();
-        float dy = y - bullet->GetY();
-        
-        // Use bullet type to determine damage and knockback
-        bool isShotgunPellet = (bullet->GetBulletType() == BulletType::SHOTGUN_PELLET);
-        // Apply damage with knockback in the direction of the bullet's travel
-        
-        TakeDamage(dx, dy, isShotgunPellet, bullet);
-        return true;
+bool Zombie::IntersectBulletPath(float x0, float y0, float x1, float y1, float halfSize, float& hitTime) const {
+    if (IsDead()) return false;
+
+    // Growing the hitbox by the bullet's half size turns box-versus-box into the bullet's
+    // center point against one box, which the slab test handles along the whole step
+    SDL_Rect hitbox = GetHitbox();
+    const float minimum[2] = {hitbox.x - halfSize, hitbox.y - halfSize};
+    const float maximum[2] = {hitbox.x + hitbox.w + halfSize, hitbox.y + hitbox.h + halfSize};
+    const float origin[2] = {x0, y0};
+    const float delta[2] = {x1 - x0, y1 - y0};
+
+    float enter = 0.0f;
+    float leave = 1.0f;
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::fabs(delta[axis]) < 1e-6f) {
+            // Not moving on this axis: it has to be inside the slab already
+            if (origin[axis] <= minimum[axis] || origin[axis] >= maximum[axis]) return false;
+            continue;
+        }
+        float inverse = 1.0f / delta[axis];
+        float slabEnter = (minimum[axis] - origin[axis]) * inverse;
+        float slabExit = (maximum[axis] - origin[axis]) * inverse;
+        if (slabEnter > slabExit) std::swap(slabEnter, slabExit);
+        enter = std::max(enter, slabEnter);
+        leave = std::min(leave, slabExit);
+        if (enter >= leave) return false;
     }
-    return false;
+    hitTime = enter;
+    return true;
 }
 
 bool Zombie::CheckCollisionWithPlayer(Player* player) {
-    if (isDead) return false;
+    if (IsDead()) return false;
 
+    SDL_Rect hitbox = GetHitbox();
     SDL_Rect playerDestRect = player->GetDestRect();
     return SDL_HasIntersection(&hitbox, &playerDestRect);
 }
 
 
 
-void Zombie::TakeDamage(float damageX, float damageY, bool isShotgunPellet, Bullet* bullet) {
-    // Only apply knockback for shotgun pellets
-    if (isShotgunPellet) {
-        float force = WeaponConfig::Shotgun::KNOCKBACK_FORCE * WeaponConfig::Shotgun::KNOCKBACK_MULTIPLIER;
-        
+void Zombie::TakeDamage(float damageX, float damageY, BulletType type) {
+    int& health = store->health[slot];
+    BulletEffect effect = GetBulletEffect(type);
+
+    // Only types with a knockback force (shotgun pellets) push the zombie
+    if (effect.knockbackForce > 0) {
         // Calculate knockback direction
         float length = std::sqrt(damageX * damageX + damageY * damageY);
         if (length > 0) {
-            knockbackVelocityX = (damageX / length) * force;
-            knockbackVelocityY = (damageY / length) * force;
+            store->knockbackVelocityX[slot] = (damageX / length) * effect.knockbackForce;
+            store->knockbackVelocityY[slot] = (damageY / length) * effect.knockbackForce;
         }
         
         // Set knockback duration
-        knockbackDuration = WeaponConfig::Shotgun::KNOCKBACK_DURATION;
+        store->knockbackDuration[slot] = effect.knockbackDuration;
     }
 
-    // Apply appropriate damage based on weapon type
-    if (isShotgunPellet) {
-        health -= WeaponConfig::Shotgun::PELLET_DAMAGE;
-    } else if (bullet && bullet->GetBulletType() == BulletType::RIFLE) {
-        health -= WeaponConfig::Rifle::DAMAGE;
-    } else {
-        health -= WeaponConfig::Pistol::DAMAGE;
-    }
+    health -= effect.damage;
     if (health <= 0) {
-        isDead = true;
+        store->dead[slot] = 1;
     }
 }
 
-void Zombie::ApplyFlockingBehavior(const std::vector<Zombie*>& zombies, float& dx, float& dy) {
-    float sepX = 0, sepY = 0;
-    float aliX = 0, aliY = 0;
-    float cohX = 0, cohY = 0;
-    
-    // Apply all three flocking behaviors
-    // - Separate: Help zombies avoid crowding together
-    // - Align: Adjust movement direction based on nearby zombies
-    // - Cohere: Help zombies move toward the center of the group
-    Separate(zombies, sepX, sepY);
-    Align(zombies, aliX, aliY);
-    Cohere(zombies, cohX, cohY);
-
-    // Balance and combine forces with corresponding weights
-    dx = dx * PLAYER_ATTRACTION_WEIGHT +  // Base force towards player
-         sepX * SEPARATION_WEIGHT +       // Repulsion force for separation
-         aliX * ALIGNMENT_WEIGHT +        // Force to align movement direction
-         cohX * COHESION_WEIGHT;         // Force to move towards group center
-
-    dy = dy * PLAYER_ATTRACTION_WEIGHT +
-         sepY * SEPARATION_WEIGHT +
-         aliY * ALIGNMENT_WEIGHT +
-         cohY * COHESION_WEIGHT;
-}
+void Zombie::AccumulateSteering(const std::vector<int>& neighbors, SteeringSums& sums) const {
+    const float separationSq = MIN_SEPARATION * MIN_SEPARATION;
+    const float neighborSq = NEIGHBOR_RADIUS * NEIGHBOR_RADIUS;
+
+    // Read the previous tick straight from the packed arrays; nobody writes these during the tick
+    const float* xs = store->prevX.data();
+    const float* ys = store->prevY.data();
+    const int* hitboxXs = store->prevHitboxX.data();
+    const int* hitboxYs = store->prevHitboxY.data();
+    const Uint8* deads = store->prevDead.data();
+    const float x = xs[slot];
+    const float y = ys[slot];
+
+    for (int other : neighbors) {
+        if (other == slot || deads[other]) continue;
+
+        float distX = x - xs[other];
+        float distY = y - ys[other];
+        float distSq = distX * distX + distY * distY;
+
+        if (distSq < separationSq) {
+            // Push zombies away from each other, +1 to create dampening effect
+            float distance = std::sqrt(distSq);
+            sums.sepX += distX / (distance + 1);
+            sums.sepY += distY / (distance + 1);
+            sums.sepCount++;
+        }
 
-void Zombie::Separate(const std::vector<Zombie*>& zombies, float& dx, float& dy) {
-    dx = dy = 0;
-    int count = 0;
-
-    for (auto other : zombies) {
-        if (other != this && !other->isDead) {
-            float distX = x - other->x;
-            float distY = y - other->y;
-            float distance = std::sqrt(distX * distX + distY * distY);
-
-            if (distance < MIN_SEPARATION) {
-                //Push zombies away from each other
-                dx += distX / (distance + 1);  // +1 to create dampening effect
-                dy += distY / (distance + 1);
-                count++;
+        if (distSq < neighborSq) {
+            // Alignment follows the same per-zombie heading vector the game has always used
+            float otherDx = hitboxXs[other] - xs[other];
+            float otherDy = hitboxYs[other] - ys[other];
+            float length = std::sqrt(otherDx * otherDx + otherDy * otherDy);
+            if (length > 0) {
+                sums.aliX += otherDx / length;
+                sums.aliY += otherDy / length;
+                sums.aliCount++;
             }
-        }
-    }
 
-    // AVerage the separation force
-    if (count > 0) {
-        dx /= count;
-        dy /= count;
-        // Normalize the direction vector
-        float length = std::sqrt(dx * dx + dy * dy);
-        if (length > 0) {
-            dx /= length;
-            dy /= length;
+            // Di chuyển dần vào với nhau
+            sums.cohX += xs[other];
+            sums.cohY += ys[other];
+            sums.cohCount++;
         }
     }
 }
 
-void Zombie::Align(const std::vector<Zombie*>& zombies, float& dx, float& dy) {
-    dx = dy = 0;
-    int count = 0;
-
-    for (auto other : zombies) {
-        if (other != this && !other->isDead) {
-            float distX = other->x - x;
-            float distY = other->y - y;
-            float distance = std::sqrt(distX * distX + distY * distY);
-
-            if (distance < NEIGHBOR_RADIUS) {
-                //Calculate the change vector
-                // Normalize the direction vector
-                float otherDx = other->hitbox.x - other->GetX();
-                float otherDy = other->hitbox.y - other->GetY();
-                float length = std::sqrt(otherDx * otherDx + otherDy * otherDy);
-                if (length > 0) {
-                    dx += otherDx / length;
-                    dy += otherDy / length;
-                    count++;
-                }
-            }
-        }
-    }
-
-    // Calculate average direction
-    if (count > 0) {
-        dx /= count;
-        dy /= count;
-        float length = std::sqrt(dx * dx + dy * dy);
-        if (length > 0) {
-            dx /= length;
-            dy /= length;
-        }
+void Zombie::BuildFormationStats(const ZombieStore& store, const std::vector<int>& slots,
+                                 float playerX, float playerY, FormationStats& stats) {
+    stats.playerX = playerX;
+    stats.playerY = playerY;
+    std::fill(std::begin(stats.occupancy), std::end(stats.occupancy), 0);
+
+    const float rangeSq = FORMATION_RANGE * FORMATION_RANGE;
+    for (int other : slots) {
+        if (store.prevDead[other]) continue;
+        float offsetX = store.prevX[other] - playerX;
+        float offsetY = store.prevY[other] - playerY;
+        if (offsetX * offsetX + offsetY * offsetY >= rangeSq) continue;
+        stats.occupancy[FormationStats::SlotOf(std::atan2(offsetY, offsetX))]++;
     }
 }
 
-void Zombie::Cohere(const std::vector<Zombie*>& zombies, float& dx, float& dy) {
-    float centerX = 0, centerY = 0;
-    int count = 0;
-
-    for (auto other : zombies) {
-        if (other != this && !other->isDead) {
-            float distX = other->x - x;
-            float distY = other->y - y;
-            float distance = std::sqrt(distX * distX + distY * distY);
-
-            if (distance < NEIGHBOR_RADIUS) {
-                centerX += other->x;
-                centerY += other->y;
-                // Di chuyển dần vào với nhau
-                count++;
+float Zombie::ChooseFormationAngle(const FormationStats& formation, float angleAroundPlayer) const {
+    // This zombie is inside formation range, so it is counted in its own slot
+    int ownSlot = FormationStats::SlotOf(angleAroundPlayer);
+    int bestSlot = ownSlot;
+    int bestCount = std::max(0, formation.occupancy[ownSlot] - 1);
+
+    // Nearest slot first, so ties keep the shortest walk. Only move for a strictly emptier slot,
+    // otherwise two equally crowded neighbors would trade zombies every tick.
+    for (int step = 1; step <= FORMATION_SEARCH_SLOTS && bestCount > 0; ++step) {
+        for (int side = -1; side <= 1; side += 2) {
+            int candidate = (ownSlot + side * step + FormationStats::SLOT_COUNT) % FormationStats::SLOT_COUNT;
+            if (formation.occupancy[candidate] < bestCount) {
+                bestSlot = candidate;
+                bestCount = formation.occupancy[candidate];
             }
         }
     }
 
-    if (count > 0) {
-        // Calculating the center of mass
-        centerX /= count;
-        centerY /= count;
-        
-        // Find the direction to the center of mass
-        dx = centerX - x;
-        dy = centerY - y;
-        
-        // Vector normalized
-        float length = std::sqrt(dx * dx + dy * dy);
-        if (length > 0) {
-            dx /= length;
-            dy /= length;
-        }
-    }
+    // Staying put holds the current bearing and only corrects the radius
+    return bestSlot == ownSlot ? angleAroundPlayer : FormationStats::SlotAngle(bestSlot);
 }
 
 void Zombie::Reset(float newX, float newY, float speedMultiplier) {
-    x = newX;
-    y = newY;
-    rotation = 0.0f;
-    health = WaveConfig::ZOMBIE_BASE_HEALTH;
-    isDead = false;
-    speed = WaveConfig::ZOMBIE_BASE_SPEED * speedMultiplier;
-    isAttacking = false;
-    lastAttackTime = 0;
-    currentFrame = 0;
-    frameTimer = 0.0f;
-    knockbackVelocityX = 0.0f;
-    knockbackVelocityY = 0.0f;
-    knockbackDuration = 0.0f;
+    store->x[slot] = newX;
+    store->y[slot] = newY;
+    store->rotation[slot] = 0.0f;
+    store->health[slot] = WaveConfig::ZOMBIE_BASE_HEALTH;
+    store->dead[slot] = 0;
+    store->speed[slot] = WaveConfig::ZOMBIE_BASE_SPEED * speedMultiplier;
+    store->attacking[slot] = 0;
+    store->lastAttackTime[slot] = 0;
+    store->currentFrame[slot] = 0;
+    store->frameTimer[slot] = 0.0f;
+    store->knockbackVelocityX[slot] = 0.0f;
+    store->knockbackVelocityY[slot] = 0.0f;
+    store->knockbackDuration[slot] = 0.0f;
+    store->velocityX[slot] = 0.0f;
+    store->velocityY[slot] = 0.0f;
     
     // Reset hitbox position
-    hitbox.x = static_cast<int>(x - hitbox.w / 2);
-    hitbox.y = static_cast<int>(y - hitbox.h / 2);
+    SyncHitbox();
 }
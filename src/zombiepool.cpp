@@ -3,20 +3,93 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <chrono>
 
 ZombiePool::ZombiePool(SDL_Renderer* renderer, size_t poolSize) 
-    : renderer(renderer) {
+    : renderer(renderer), highWaterMark(0), growthCount(0), neighborGrid(Zombie::NEIGHBOR_QUERY_RADIUS), flowField(nullptr), simulation(nullptr), optimizeTimer(0.0f), combineSteering(nullptr), workers(nullptr),
+      farTierRadius(DEFAULT_VIEW_RADIUS + NEAR_TIER_MARGIN + MID_TIER_BAND + GROUP_JOIN_MARGIN), distanceScale(1.0f), steeringInterval(1), aiMicroseconds(0.0f), aiWork(0.0f), steeredLastTick(0), tickCount(0),
+      collisionGrid(COLLISION_CELL_SIZE), colliderRadius(0.0f) {
+    // Workers first, so ReserveCapacity also sizes their scratch buffers
+    workers = new WorkerPool();
+    workerScratch.resize(workers->GetThreadCount());
+
     // Reserve space for our vectors
-    pool.reserve(poolSize);
-    activeZombies.reserve(poolSize);
-    isInUse.reserve(poolSize);
+    ReserveCapacity(poolSize);
+
+    // Every zombie shares one set of textures
+    assets.Load(renderer);
+    colliderRadius = 0.5f * std::min(assets.hitboxWidth, assets.hitboxHeight) * COLLIDER_SCALE;
+
+    combineSteering = SteeringKernels::Select();
+    std::cout << "ZombiePool: Using " << SteeringKernels::GetSelectedName() << " steering kernel" << std::endl;
+
+    std::cout << "ZombiePool: Updating zombies on " << workers->GetThreadCount() << " threads" << std::endl;
 }
 
 void ZombiePool::AddZombie() {
     // Create zombie off-screen initially
-    Zombie* zombie = new Zombie(renderer, -1000.0f, -1000.0f);
+    Zombie* zombie = new Zombie(&store, &assets, -1000.0f, -1000.0f);
     pool.push_back(zombie);
-    isInUse.push_back(false);  // Mark as not in use initially
+    activeIndex.push_back(-1);
+    groupOf.push_back(-1);
+    groupAnchorX.push_back(0.0f);
+    groupAnchorY.push_back(0.0f);
+    freeSlots.push_back(zombie->GetSlot());
+}
+
+void ZombiePool::ReserveCapacity(size_t capacity) {
+    // Everything sized per zombie, so neither spawning nor the tick reallocates below this
+    pool.reserve(capacity);
+    store.Reserve(capacity);
+    activeZombies.reserve(capacity);
+    activeSlots.reserve(capacity);
+    activeIndex.reserve(capacity);
+    freeSlots.reserve(capacity);
+    recycleScratch.reserve(capacity);
+    updatedSlots.reserve(capacity);
+    gridX.reserve(capacity);
+    gridY.reserve(capacity);
+    landedHits.reserve(capacity);
+    laneActions.reserve(capacity);
+    farMembers.reserve(capacity);
+    farGroups.reserve(capacity);
+    freeGroups.reserve(capacity);
+    groupCells.reserve(capacity);
+    groupOf.reserve(capacity);
+    groupAnchorX.reserve(capacity);
+    groupAnchorY.reserve(capacity);
+    bodySlots.reserve(capacity);
+    bodyX.reserve(capacity);
+    bodyY.reserve(capacity);
+    correctionX.reserve(capacity);
+    correctionY.reserve(capacity);
+    contacts.reserve(capacity * MAX_CONTACTS);
+    contactCounts.reserve(capacity);
+    neighborGrid.Reserve(capacity);
+    collisionGrid.Reserve(capacity);
+    steeringBatch.Reserve(capacity);
+    // A query reports each point at most once, so neither buffer can outgrow the pool
+    for (WorkerScratch& scratch : workerScratch) {
+        scratch.query.reserve(capacity);
+        scratch.neighbors.reserve(capacity);
+    }
+}
+
+bool ZombiePool::Grow() {
+    size_t capacity = pool.size();
+    if (capacity >= MAX_CAPACITY) {
+        return false;
+    }
+
+    // Grow by half so repeated growth stays amortized O(1) per zombie
+    size_t newCapacity = std::min(MAX_CAPACITY, capacity + std::max(MIN_GROWTH, capacity / 2));
+    ReserveCapacity(newCapacity);
+    while (pool.size() < newCapacity) {
+        AddZombie();
+    }
+    growthCount++;
+    std::cout << "ZombiePool: Grew from " << capacity << " to " << newCapacity << " zombies" << std::endl;
+    return true;
 }
 
 ZombiePool::~ZombiePool() {
@@ -24,9 +97,12 @@ ZombiePool::~ZombiePool() {
         for (Zombie* zombie : pool) {
             delete zombie;
         }
+        delete workers;
+        workers = nullptr;
         pool.clear();
         activeZombies.clear();
-        isInUse.clear();
+        activeSlots.clear();
+        assets.Free();
     } catch (...) {
         std::cerr << "ZombiePool: Error during cleanup" << std::endl;
     }
@@ -41,77 +117,84 @@ void ZombiePool::SetDebugHitboxForAll(bool show) {
     }
 }
 
-Zombie* ZombiePool::GetZombie() {
-    // First check recycled zombies
-    if (!recycledZombies.empty()) {
-        Zombie* zombie = recycledZombies.front();
-        recycledZombies.pop();
-        activeZombies.push_back(zombie);
-        return zombie;
+int ZombiePool::AcquireSlot() {
+    if (freeSlots.empty() && !Grow()) {
+        std::cerr << "ZombiePool: No available zombies in pool" << std::endl;
+        return -1;
     }
 
-    // If no recycled zombies, get one from the pool
-    try {
-        for (size_t i = 0; i < pool.size(); ++i) {
-            if (!isInUse[i] && pool[i] != nullptr) {
-                isInUse[i] = true;
-                activeZombies.push_back(pool[i]);
-                
-                // Log pool usage stats
-                size_t activeCount = std::count(isInUse.begin(), isInUse.end(), true);
-                if (activeCount > pool.size() * 0.8f) {
-                    std::cout << "ZombiePool: High usage warning - " << activeCount << "/" 
-                              << pool.size() << " zombies active" << std::endl;
-                    // Trigger aggressive recycling when pool is nearly full
-                    return pool[i];
-                }
-                
-                return pool[i];
-            }
-        }
-        std::cerr << "ZombiePool: No available zombies in pool" << std::endl;
-        return nullptr;
-    } catch (const std::exception& e) {
-        std::cerr << "ZombiePool: Error in GetZombie: " << e.what() << std::endl;
-        return nullptr;
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    activeIndex[slot] = static_cast<int>(activeZombies.size());
+    activeZombies.push_back(pool[slot]);
+    activeSlots.push_back(slot);
+    highWaterMark = std::max(highWaterMark, activeZombies.size());
+    return slot;
+}
+
+void ZombiePool::ReleaseSlot(int slot) {
+    int index = activeIndex[slot];
+    if (index < 0) {
+        return;  // Already free
+    }
+    if (groupOf[slot] >= 0) {
+        LeaveGroup(slot);
+    }
+
+    // Swap-and-pop: the last active zombie takes over the hole
+    int lastSlot = activeSlots.back();
+    activeZombies[index] = activeZombies.back();
+    activeSlots[index] = lastSlot;
+    activeIndex[lastSlot] = index;
+    activeZombies.pop_back();
+    activeSlots.pop_back();
+    activeIndex[slot] = -1;
+    freeSlots.push_back(slot);
+    // Every handle to the zombie that just left goes stale
+    store.generation[slot]++;
+}
+
+ZombieHandle ZombiePool::GetZombie() {
+    ZombieHandle handle;
+    int slot = AcquireSlot();
+    if (slot >= 0) {
+        handle.index = slot;
+        handle.generation = store.generation[slot];
     }
+    return handle;
 }
 
-void ZombiePool::ReturnZombie(Zombie* zombie) {
-    if (!zombie) {
+void ZombiePool::ReturnZombie(ZombieHandle handle) {
+    if (handle.IsNull()) {
         std::cerr << "ZombiePool: Attempted to return null zombie" << std::endl;
         return;
     }
+    if (!Resolve(handle)) {
+        std::cerr << "ZombiePool: Attempted to return a stale or foreign zombie handle" << std::endl;
+        return;
+    }
+    ReleaseSlot(handle.index);
+}
 
-    try {
-        // Find and mark the zombie as not in use
-        bool found = false;
-        for (size_t i = 0; i < pool.size(); ++i) {
-            // Check if the pointer to the zombie is in the pool and is in use
-            if (pool[i] == zombie) {
-                isInUse[i] = false;
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
-            std::cerr << "ZombiePool: Attempted to return zombie not from this pool" << std::endl;
-            return;
-        }
-
-        // Remove from active zombies using the erase-remove idiom
-        activeZombies.erase(
-            std::remove(activeZombies.begin(), activeZombies.end(), zombie),
-            activeZombies.end()
-        );
+Zombie* ZombiePool::Resolve(ZombieHandle handle) const {
+    if (handle.index < 0 || static_cast<size_t>(handle.index) >= pool.size()) return nullptr;
+    if (store.generation[handle.index] != handle.generation || activeIndex[handle.index] < 0) return nullptr;
+    return pool[handle.index];
+}
 
-    } catch (const std::exception& e) {
-        std::cerr << "ZombiePool: Error in ReturnZombie: " << e.what() << std::endl;
+ZombieHandle ZombiePool::GetHandle(const Zombie* zombie) const {
+    ZombieHandle handle;
+    if (!zombie) return handle;
+    int slot = zombie->GetSlot();
+    if (slot < 0 || static_cast<size_t>(slot) >= pool.size() || pool[slot] != zombie || activeIndex[slot] < 0) {
+        return handle;
     }
+    handle.index = slot;
+    handle.generation = store.generation[slot];
+    return handle;
 }
 
-void ZombiePool::Update(float deltaTime, Player* player) {
+void ZombiePool::Update(float deltaTime, Player* player, const Camera* camera) {
     if (!player) {
         std::cerr << "ZombiePool: Null player in Update" << std::endl;
         return;
@@ -119,24 +202,109 @@ void ZombiePool::Update(float deltaTime, Player* player) {
 
     try {
         // Update zombie distances and recycle if needed
+        distanceScale = camera ? camera->GetDistanceScale() : 1.0f;
         UpdateZombieDistances(player);
         
-        // Copy to prevent modification during iteration
-        std::vector<Zombie*> currentActive = activeZombies;
+        auto aiStart = std::chrono::steady_clock::now();
+        Uint32 currentTime = simulation ? simulation->GetTimeMs() : 0;
+
+        // Lanes follow activeSlots directly; nothing is acquired or released until the recycling below
+        BuildNeighborGrid();
         
-        for (Zombie* zombie : currentActive) {
-            if (zombie && !zombie->IsDead()) {
-                zombie->Update(deltaTime, player, currentActive);
-                
-                // If zombie died or is too far, recycle it
-                if (zombie->IsDead() || IsZombieTooFar(zombie, player, RECYCLE_DISTANCE)) {
-                    ReturnZombie(zombie);
+        // Freeze this tick's read state: every zombie steers from where the others were
+        store.SnapshotPrevious();
+        Zombie::BuildFormationStats(store, activeSlots, player->GetX(), player->GetY(), formationStats);
+
+        // Decide how much work each zombie gets this tick; far groups move here, once per group
+        ClassifyLanes(player, camera);
+        JoinFarGroups();
+        MoveFarGroups(player, deltaTime);
+        tickCount++;
+
+        // Phase 1: per-zombie gather, in parallel
+        size_t laneCount = activeSlots.size();
+        steeringBatch.Resize(laneCount);
+        for (WorkerScratch& scratch : workerScratch) {
+            scratch.neighborVisits = 0;
+        }
+        workers->ParallelFor(laneCount, ZOMBIES_PER_TASK, [&](size_t begin, size_t end, unsigned worker) {
+            WorkerScratch& scratch = workerScratch[worker];
+            for (size_t i = begin; i < end; ++i) {
+                int slot = activeSlots[i];
+                if (laneActions[i] != static_cast<Uint8>(LaneAction::STEER)) {
+                    if (laneActions[i] == static_cast<Uint8>(LaneAction::FOLLOW) ||
+                        laneActions[i] == static_cast<Uint8>(LaneAction::COAST)) {
+                        pool[slot]->Coast(deltaTime);
+                    }
+                    steeringBatch.SetIdle(i);
+                    continue;
+                }
+                GatherNeighbors(i, scratch);
+                if (!pool[slot]->PrepareSteering(deltaTime, player, formationStats, flowField, scratch.neighbors, steeringBatch, i)) {
+                    steeringBatch.SetIdle(i);
                 }
             }
+        });
+
+        // Phase 2: weigh, normalize and integrate, then the per-zombie finish (contact, attacks, animation)
+        landedHits.assign(laneCount, 0);
+        workers->ParallelFor(laneCount, ZOMBIES_PER_TASK, [&](size_t begin, size_t end, unsigned) {
+            combineSteering(steeringBatch, begin, end, deltaTime, Zombie::STEERING_WEIGHTS);
+            for (size_t lane = begin; lane < end; ++lane) {
+                int slot = steeringBatch.slot[lane];
+                if (slot < 0) {
+                    // Zombies following their cached vector still bite and animate
+                    if (laneActions[lane] == static_cast<Uint8>(LaneAction::FOLLOW)) {
+                        landedHits[lane] = pool[activeSlots[lane]]->FinishUpdate(deltaTime, player, currentTime) ? 1 : 0;
+                    }
+                    continue;
+                }
+                store.x[slot] = steeringBatch.posX[lane];
+                store.y[slot] = steeringBatch.posY[lane];
+                if (deltaTime > 0) {
+                    // Remembered so the zombie can coast on it if it drops to a cheaper tier
+                    store.velocityX[slot] = (steeringBatch.posX[lane] - store.prevX[slot]) / deltaTime;
+                    store.velocityY[slot] = (steeringBatch.posY[lane] - store.prevY[slot]) / deltaTime;
+                }
+                landedHits[lane] = pool[slot]->FinishUpdate(deltaTime, player, currentTime) ? 1 : 0;
+            }
+        });
+
+        // Push overlapping zombies apart, and out of the player
+        ResolveCrowdCollisions(player);
+
+        // Phase 3: the player is shared, so hits land here on one thread, in lane order
+        for (size_t lane = 0; lane < laneCount; ++lane) {
+            if (landedHits[lane]) {
+                player->TakeDamage(WaveConfig::ZOMBIE_BASE_DAMAGE);
+            }
+        }
+
+        float elapsedMicroseconds = std::chrono::duration<float, std::micro>(
+            std::chrono::steady_clock::now() - aiStart).count();
+        aiMicroseconds += (elapsedMicroseconds - aiMicroseconds) * 0.1f;
+        size_t neighborVisits = 0;
+        for (const WorkerScratch& scratch : workerScratch) {
+            neighborVisits += scratch.neighborVisits;
+        }
+        AdaptSteeringInterval(static_cast<float>(neighborVisits));
+
+        updatedSlots.clear();
+        for (int slot : activeSlots) {
+            if (!store.prevDead[slot]) {
+                updatedSlots.push_back(slot);
+            }
+        }
+
+        // If zombie died or is too far, recycle it
+        for (int slot : updatedSlots) {
+            Zombie* zombie = pool[slot];
+            if (zombie->IsDead() || IsZombieTooFar(zombie, player, RECYCLE_DISTANCE * distanceScale)) {
+                ReleaseSlot(slot);
+            }
         }
 
         // Optimize zombie distribution periodically
-        static float optimizeTimer = 0.0f;
         optimizeTimer += deltaTime;
         if (optimizeTimer >= 1.0f) {  // Optimize every second
             OptimizeZombieDistribution(player);
@@ -147,6 +315,327 @@ void ZombiePool::Update(float deltaTime, Player* player) {
     }
 }
 
+void ZombiePool::BuildNeighborGrid() {
+    gridX.resize(activeSlots.size());
+    gridY.resize(activeSlots.size());
+    for (size_t i = 0; i < activeSlots.size(); ++i) {
+        gridX[i] = store.x[activeSlots[i]];
+        gridY[i] = store.y[activeSlots[i]];
+    }
+    neighborGrid.Build(gridX.data(), gridY.data(), activeSlots.size());
+}
+
+void ZombiePool::ClassifyLanes(const Player* player, const Camera* camera) {
+    float viewRadius = camera ? camera->GetWorldViewRadius() : DEFAULT_VIEW_RADIUS;
+    float nearRadius = viewRadius + NEAR_TIER_MARGIN;
+    float groupRadius = nearRadius + MID_TIER_BAND;
+    float joinRadius = groupRadius + GROUP_JOIN_MARGIN;
+    float nearSq = nearRadius * nearRadius;
+    float groupSq = groupRadius * groupRadius;
+    float joinSq = joinRadius * joinRadius;
+    farTierRadius = joinRadius;
+
+    float playerX = player->GetX();
+    float playerY = player->GetY();
+
+    // A group breaks up as soon as one live member is inside the group radius
+    for (FarGroup& group : farGroups) {
+        group.splitting = false;
+    }
+    for (int slot : activeSlots) {
+        int group = groupOf[slot];
+        if (group < 0 || store.dead[slot]) continue;
+        float dx = store.x[slot] - playerX;
+        float dy = store.y[slot] - playerY;
+        if (dx * dx + dy * dy < groupSq) {
+            farGroups[group].splitting = true;
+        }
+    }
+
+    laneActions.assign(activeSlots.size(), static_cast<Uint8>(LaneAction::IDLE));
+    farMembers.clear();
+    steeredLastTick = 0;
+    for (size_t i = 0; i < activeSlots.size(); ++i) {
+        int slot = activeSlots[i];
+        int group = groupOf[slot];
+        if (group >= 0) {
+            // Members stay put inside their group until it splits, they die or they are knocked back
+            if (!store.dead[slot] && !farGroups[group].splitting && store.knockbackDuration[slot] <= 0) {
+                laneActions[i] = static_cast<Uint8>(LaneAction::GROUP);
+                continue;
+            }
+            LeaveGroup(slot);
+        }
+        if (store.dead[slot]) continue;
+
+        float dx = store.x[slot] - playerX;
+        float dy = store.y[slot] - playerY;
+        float distSq = dx * dx + dy * dy;
+        // Stagger by slot so the recomputed subset rotates evenly over ticks
+        unsigned phase = static_cast<unsigned>(slot) + tickCount;
+        bool hasCachedSteering = store.velocityX[slot] != 0.0f || store.velocityY[slot] != 0.0f;
+        LaneAction action = LaneAction::STEER;  // Knockback always runs in full so hits look right
+        if (store.knockbackDuration[slot] > 0 || !hasCachedSteering) {
+            // Nothing cached to follow yet
+        } else if (distSq < nearSq) {
+            action = phase % steeringInterval == 0 ? LaneAction::STEER : LaneAction::FOLLOW;
+        } else if (distSq < joinSq) {
+            bool steersThisTick = phase % (MID_STEER_INTERVAL * steeringInterval) == 0;
+            action = steersThisTick ? LaneAction::STEER : LaneAction::COAST;
+        } else {
+            // Joins a group in JoinFarGroups, after every split and leave of this tick
+            action = LaneAction::GROUP;
+            long long cellX = static_cast<long long>(std::floor(store.x[slot] / GROUP_CELL_SIZE));
+            long long cellY = static_cast<long long>(std::floor(store.y[slot] / GROUP_CELL_SIZE));
+            farMembers.push_back({(cellX << 32) ^ (cellY & 0xffffffffLL), slot});
+        }
+        laneActions[i] = static_cast<Uint8>(action);
+        if (action == LaneAction::STEER) {
+            steeredLastTick++;
+        }
+    }
+}
+
+void ZombiePool::ResolveCrowdCollisions(const Player* player) {
+    // Bodies: every live zombie that is not part of a far group
+    bodySlots.clear();
+    for (size_t lane = 0; lane < activeSlots.size(); ++lane) {
+        Uint8 action = laneActions[lane];
+        if (action != static_cast<Uint8>(LaneAction::IDLE) && action != static_cast<Uint8>(LaneAction::GROUP)) {
+            bodySlots.push_back(activeSlots[lane]);
+        }
+    }
+    size_t bodyCount = bodySlots.size();
+    if (bodyCount == 0 || colliderRadius <= 0.0f) return;
+
+    bodyX.resize(bodyCount);
+    bodyY.resize(bodyCount);
+    correctionX.resize(bodyCount);
+    correctionY.resize(bodyCount);
+    contacts.resize(bodyCount * MAX_CONTACTS);
+    contactCounts.resize(bodyCount);
+    for (size_t body = 0; body < bodyCount; ++body) {
+        bodyX[body] = store.x[bodySlots[body]];
+        bodyY[body] = store.y[bodySlots[body]];
+    }
+
+    // Broad phase: collect each body's overlapping neighbors once
+    const float diameter = 2.0f * colliderRadius;
+    const float diameterSq = diameter * diameter;
+    collisionGrid.Build(bodyX.data(), bodyY.data(), bodyCount);
+    workers->ParallelFor(bodyCount, ZOMBIES_PER_TASK, [&](size_t begin, size_t end, unsigned worker) {
+        std::vector<int>& query = workerScratch[worker].query;
+        for (size_t body = begin; body < end; ++body) {
+            query.clear();
+            collisionGrid.Query(bodyX[body], bodyY[body], diameter, query);
+            std::sort(query.begin(), query.end());  // Same contacts kept whatever the bucket order
+
+            int count = 0;
+            int* bodyContacts = &contacts[body * MAX_CONTACTS];
+            for (int other : query) {
+                if (other == static_cast<int>(body)) continue;
+                float dx = bodyX[body] - bodyX[other];
+                float dy = bodyY[body] - bodyY[other];
+                if (dx * dx + dy * dy >= diameterSq) continue;
+                bodyContacts[count++] = other;
+                if (count == MAX_CONTACTS) break;
+            }
+            contactCounts[body] = count;
+        }
+    });
+
+    // Relaxation: each pass computes every correction from the previous positions, then applies them
+    const float playerX = player->GetX();
+    const float playerY = player->GetY();
+    const float playerContact = colliderRadius + PLAYER_COLLIDER_RADIUS;
+    for (int iteration = 0; iteration < CROWD_ITERATIONS; ++iteration) {
+        workers->ParallelFor(bodyCount, ZOMBIES_PER_TASK, [&](size_t begin, size_t end, unsigned) {
+            for (size_t body = begin; body < end; ++body) {
+                float sumX = 0.0f, sumY = 0.0f;
+                int constraints = 0;
+                const int* bodyContacts = &contacts[body * MAX_CONTACTS];
+                for (int k = 0; k < contactCounts[body]; ++k) {
+                    int other = bodyContacts[k];
+                    float dx = bodyX[body] - bodyX[other];
+                    float dy = bodyY[body] - bodyY[other];
+                    float distance = std::sqrt(dx * dx + dy * dy);
+                    if (distance >= diameter) continue;
+                    if (distance < 0.001f) {
+                        // Exactly stacked: split them along a fixed axis chosen by index
+                        dx = (static_cast<int>(body) < other) ? -1.0f : 1.0f;
+                        dy = 0.0f;
+                        distance = 1.0f;
+                    }
+                    // Both zombies move, so each takes half of the overlap
+                    float push = 0.5f * (diameter - distance) / distance;
+                    sumX += dx * push;
+                    sumY += dy * push;
+                    constraints++;
+                }
+
+                // The player does not move: the zombie takes the whole overlap
+                float dx = bodyX[body] - playerX;
+                float dy = bodyY[body] - playerY;
+                float distance = std::sqrt(dx * dx + dy * dy);
+                if (distance < playerContact && distance > 0.001f) {
+                    float push = (playerContact - distance) / distance;
+                    sumX += dx * push;
+                    sumY += dy * push;
+                    constraints++;
+                }
+
+                // A lone contact is resolved exactly; shared ones are averaged and over-relaxed
+                float scale = constraints > 0 ? std::min(1.0f, CROWD_RELAXATION / constraints) : 0.0f;
+                correctionX[body] = sumX * scale;
+                correctionY[body] = sumY * scale;
+            }
+        });
+        for (size_t body = 0; body < bodyCount; ++body) {
+            bodyX[body] += correctionX[body];
+            bodyY[body] += correctionY[body];
+        }
+    }
+
+    for (size_t body = 0; body < bodyCount; ++body) {
+        int slot = bodySlots[body];
+        if (bodyX[body] != store.x[slot] || bodyY[body] != store.y[slot]) {
+            pool[slot]->MoveTo(bodyX[body], bodyY[body]);
+        }
+    }
+}
+
+void ZombiePool::AdaptSteeringInterval(float neighborVisits) {
+    aiWork += (neighborVisits - aiWork) * 0.1f;
+    if (tickCount % ADAPT_EVERY_TICKS != 0) return;
+
+    if (aiWork > AI_WORK_BUDGET && steeringInterval < MAX_STEERING_INTERVAL) {
+        steeringInterval++;
+    } else if (aiWork < AI_WORK_BUDGET * 0.5f && steeringInterval > 1) {
+        steeringInterval--;
+    }
+}
+
+void ZombiePool::JoinGroup(int slot, int group) {
+    FarGroup& target = farGroups[group];
+    groupOf[slot] = group;
+    groupAnchorX[slot] = store.x[slot] - target.offsetX;
+    groupAnchorY[slot] = store.y[slot] - target.offsetY;
+    target.anchorSumX += groupAnchorX[slot];
+    target.anchorSumY += groupAnchorY[slot];
+    target.speedSum += store.speed[slot];
+    target.count++;
+}
+
+void ZombiePool::LeaveGroup(int slot) {
+    int group = groupOf[slot];
+    FarGroup& source = farGroups[group];
+    groupOf[slot] = -1;
+    // Its position is already current (MoveFarGroups places members every tick); it keeps coasting
+    // on the group's velocity until it steers for itself
+    store.velocityX[slot] = source.velocityX;
+    store.velocityY[slot] = source.velocityY;
+    store.rotation[slot] = source.rotation;
+    source.count--;
+    if (source.count == 0) {
+        freeGroups.push_back(group);
+        return;
+    }
+    source.anchorSumX -= groupAnchorX[slot];
+    source.anchorSumY -= groupAnchorY[slot];
+    source.speedSum -= store.speed[slot];
+}
+
+void ZombiePool::JoinFarGroups() {
+    if (farMembers.empty()) return;
+
+    // Live groups by the cell their centroid is in; a zombie joins the group of its own cell
+    groupCells.clear();
+    for (size_t group = 0; group < farGroups.size(); ++group) {
+        const FarGroup& candidate = farGroups[group];
+        if (candidate.count == 0 || candidate.splitting) continue;
+        float centerX = candidate.anchorSumX / candidate.count + candidate.offsetX;
+        float centerY = candidate.anchorSumY / candidate.count + candidate.offsetY;
+        long long cellX = static_cast<long long>(std::floor(centerX / GROUP_CELL_SIZE));
+        long long cellY = static_cast<long long>(std::floor(centerY / GROUP_CELL_SIZE));
+        groupCells.push_back({(cellX << 32) ^ (cellY & 0xffffffffLL), static_cast<int>(group)});
+    }
+    std::sort(groupCells.begin(), groupCells.end());
+
+    // Sorted by cell, then slot, so groups form the same way on every run
+    std::sort(farMembers.begin(), farMembers.end());
+    for (size_t begin = 0; begin < farMembers.size();) {
+        long long key = farMembers[begin].first;
+        auto found = std::lower_bound(groupCells.begin(), groupCells.end(), std::make_pair(key, -1));
+        int group;
+        if (found != groupCells.end() && found->first == key) {
+            group = found->second;
+        } else {
+            if (!freeGroups.empty()) {
+                group = freeGroups.back();
+                freeGroups.pop_back();
+            } else {
+                group = static_cast<int>(farGroups.size());
+                farGroups.push_back(FarGroup());
+            }
+            farGroups[group] = FarGroup();
+        }
+        for (; begin < farMembers.size() && farMembers[begin].first == key; ++begin) {
+            JoinGroup(farMembers[begin].second, group);
+        }
+    }
+}
+
+void ZombiePool::MoveFarGroups(const Player* player, float deltaTime) {
+    // One steering decision and one move per group, taken at its centroid
+    for (FarGroup& group : farGroups) {
+        if (group.count == 0) continue;
+        float count = static_cast<float>(group.count);
+        float centerX = group.anchorSumX / count + group.offsetX;
+        float centerY = group.anchorSumY / count + group.offsetY;
+        float dirX = player->GetX() - centerX;
+        float dirY = player->GetY() - centerY;
+        float pathX, pathY;
+        if (flowField && flowField->Sample(centerX, centerY, pathX, pathY)) {
+            dirX = pathX;
+            dirY = pathY;
+        } else {
+            float length = std::sqrt(dirX * dirX + dirY * dirY);
+            if (length > 0) {
+                dirX /= length;
+                dirY /= length;
+            }
+        }
+        float groupSpeed = group.speedSum / count;
+        group.velocityX = dirX * groupSpeed;
+        group.velocityY = dirY * groupSpeed;
+        group.offsetX += group.velocityX * deltaTime;
+        group.offsetY += group.velocityY * deltaTime;
+        group.rotation = std::atan2(dirY, dirX) * 180.0f / M_PI;
+    }
+
+    // Members are placed, not simulated: anchor plus the group's offset, for bullets and drawing
+    for (int slot : activeSlots) {
+        int group = groupOf[slot];
+        if (group < 0) continue;
+        const FarGroup& owner = farGroups[group];
+        store.rotation[slot] = owner.rotation;
+        pool[slot]->MoveTo(groupAnchorX[slot] + owner.offsetX, groupAnchorY[slot] + owner.offsetY);
+    }
+}
+
+void ZombiePool::GatherNeighbors(size_t index, WorkerScratch& scratch) {
+    scratch.query.clear();
+    neighborGrid.Query(gridX[index], gridY[index], Zombie::NEIGHBOR_QUERY_RADIUS, scratch.query);
+
+    // Ascending order keeps the flocking sums deterministic and the slot reads moving forward
+    std::sort(scratch.query.begin(), scratch.query.end());
+    scratch.neighbors.clear();
+    for (int other : scratch.query) {
+        scratch.neighbors.push_back(activeSlots[other]);
+    }
+    scratch.neighborVisits += scratch.neighbors.size();
+}
+
 void ZombiePool::Render(SDL_Renderer* renderer, Camera* camera) {
     if (!renderer || !camera) {
         std::cerr << "ZombiePool: Null renderer or camera in Render" << std::endl;
@@ -165,17 +654,16 @@ void ZombiePool::Render(SDL_Renderer* renderer, Camera* camera) {
 }
 
 void ZombiePool::RecycleDistantZombies(Player* player, float maxDistance) {
-    std::vector<Zombie*> zombiesToRecycle;
-    
-    for (Zombie* zombie : activeZombies) {
-        if (IsZombieTooFar(zombie, player, maxDistance)) {
-            zombiesToRecycle.push_back(zombie);
+    // Returning reorders activeZombies, so collect first
+    recycleScratch.clear();
+    for (int slot : activeSlots) {
+        if (IsZombieTooFar(pool[slot], player, maxDistance)) {
+            recycleScratch.push_back(slot);
         }
     }
     
-    for (Zombie* zombie : zombiesToRecycle) {
-        ReturnZombie(zombie);
-        recycledZombies.push(zombie);
+    for (int slot : recycleScratch) {
+        ReleaseSlot(slot);
     }
 }
 
@@ -184,19 +672,15 @@ void ZombiePool::OptimizeZombieDistribution(Player* player) {
     
     // If we're using too many zombies, recycle distant ones
     if (activeCount > pool.size() * 0.8f) {
-        RecycleDistantZombies(player, MIN_RECYCLE_DISTANCE);
+        RecycleDistantZombies(player, MIN_RECYCLE_DISTANCE * distanceScale);
     }
     
     // Ensure zombies are well-distributed around the player
-    std::vector<Zombie*> poorlyPlaced;
+    // Reposition poorly placed zombies (in place, so no need to collect them first). The far tier
+    // is left alone: its groups already close in on the player, and moving a member would break one up.
     for (Zombie* zombie : activeZombies) {
-        if (IsZombieTooFar(zombie, player, OPTIMAL_DISTANCE)) {
-            poorlyPlaced.push_back(zombie);
-        }
-    }
-    
-    // Reposition poorly placed zombies
-    for (Zombie* zombie : poorlyPlaced) {
+        if (!IsZombieTooFar(zombie, player, OPTIMAL_DISTANCE * distanceScale)) continue;
+        if (groupOf[zombie->GetSlot()] >= 0 || IsZombieTooFar(zombie, player, farTierRadius)) continue;
         SDL_Point newPos = GetOptimalSpawnPosition(player);
         zombie->Reset(static_cast<float>(newPos.x), static_cast<float>(newPos.y));
     }
@@ -214,17 +698,17 @@ bool ZombiePool::IsZombieTooFar(const Zombie* zombie, const Player* player, floa
 
 void ZombiePool::UpdateZombieDistances(Player* player) {
     // Recycle zombies that are too far from the player
-    RecycleDistantZombies(player, RECYCLE_DISTANCE);
+    RecycleDistantZombies(player, RECYCLE_DISTANCE * distanceScale);
 }
 
-SDL_Point ZombiePool::GetOptimalSpawnPosition(Player* player) const {
+SDL_Point ZombiePool::GetOptimalSpawnPosition(Player* player) {
     // Generate a position at optimal distance from player
-    //rand() / RAND_MAX gives a float between 0 and 1
-    // Multiply by 2 * PI to get a random angle
-    float randomAngle = static_cast<float>(rand()) / RAND_MAX * 2.0f * M_PI;
+    // NextFloat() gives a float in [0, 1); multiply by 2 * PI to get a random angle
+    Pcg32* random = simulation ? &simulation->GetRandom(RandomStream::ZOMBIES) : nullptr;
+    float randomAngle = (random ? random->NextFloat() : 0.0f) * 2.0f * M_PI;
     // Calculate distance based on optimal distance and some randomness
-    // This will create a range between 0.6 * OPTIMAL_DISTANCE and 1.4 * OPTIMAL_DISTANCE
-    float distance = OPTIMAL_DISTANCE * (1.0f + 0.4f * static_cast<float>(rand()) / RAND_MAX);
+    // This will create a range between the scaled OPTIMAL_DISTANCE and (1 + REPOSITION_SPREAD) times it
+    float distance = OPTIMAL_DISTANCE * distanceScale * (1.0f + REPOSITION_SPREAD * (random ? random->NextFloat() : 0.0f));
     
     SDL_Point pos;
     pos.x = static_cast<int>(player->GetX() + cos(randomAngle) * distance);
@@ -232,14 +716,3 @@ SDL_Point ZombiePool::GetOptimalSpawnPosition(Player* player) const {
     
     return pos;
 }
-
-void ZombiePool::PrewarmPool() {
-    // Create some initial zombies to prevent stutter when first spawning
-    for (size_t i = 0; i < pool.size() / 4; ++i) {
-        Zombie* zombie = GetZombie();
-        if (zombie) {
-            ReturnZombie(zombie);
-            recycledZombies.push(zombie);
-        }
-    }
-}
\ No newline at end of file
@@ -0,0 +1,129 @@
+// Checks SpatialGrid queries against a brute-force scan at the zombie counts the game runs at.
+// Every point within the radius must be reported exactly once; extra candidates are allowed.
+#include "SpatialGrid.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    int failures = 0;
+
+    void Check(bool condition, const char* what, size_t count, size_t index) {
+        if (!condition) {
+            if (failures < 20) {
+                std::printf("FAIL %s (count %zu, point %zu)\n", what, count, index);
+            }
+            ++failures;
+        }
+    }
+
+    // Half the points spread over the recycle disk, half packed around the player the way a horde is
+    void FillPoints(size_t count, std::vector<float>& xs, std::vector<float>& ys) {
+        uint32_t state = 2024u + static_cast<uint32_t>(count);
+        auto next = [&state]() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        };
+        xs.resize(count);
+        ys.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            float radius = (i % 2 == 0) ? 1200.0f : 300.0f;
+            float angle = next() * 6.2831853f;
+            float distance = std::sqrt(next()) * radius;
+            xs[i] = 500.0f + std::cos(angle) * distance;
+            ys[i] = -700.0f + std::sin(angle) * distance;
+        }
+    }
+
+    // Distance from (px, py) to the segment (x0, y0)-(x1, y1), per axis like QuerySegment's radius
+    bool NearSegment(float px, float py, float x0, float y0, float x1, float y1, float radius) {
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        float lengthSq = dx * dx + dy * dy;
+        float t = lengthSq > 0.0f ? ((px - x0) * dx + (py - y0) * dy) / lengthSq : 0.0f;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        float ox = px - (x0 + t * dx);
+        float oy = py - (y0 + t * dy);
+        return std::fabs(ox) <= radius && std::fabs(oy) <= radius;
+    }
+
+    void TestQuery(size_t count) {
+        const float cellSize = 104.0f; // Zombie::NEIGHBOR_QUERY_RADIUS
+        const float radius = cellSize;
+        std::vector<float> xs, ys;
+        FillPoints(count, xs, ys);
+
+        SpatialGrid grid(cellSize);
+        grid.Build(xs.data(), ys.data(), count);
+        Check(grid.GetCount() == count, "GetCount", count, 0);
+
+        std::vector<int> candidates;
+        std::vector<int> seen(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            candidates.clear();
+            grid.Query(xs[i], ys[i], radius, candidates);
+            for (int index : candidates) {
+                seen[index]++;
+            }
+            for (size_t j = 0; j < count; ++j) {
+                float dx = xs[j] - xs[i];
+                float dy = ys[j] - ys[i];
+                if (dx * dx + dy * dy <= radius * radius) {
+                    Check(seen[j] == 1, "Query missed or repeated a neighbor", count, i);
+                }
+            }
+            for (int index : candidates) {
+                seen[index] = 0;
+            }
+        }
+    }
+
+    void TestQuerySegment(size_t count) {
+        const float cellSize = 64.0f; // CollisionSystem::CELL_SIZE
+        const float radius = 20.0f;
+        std::vector<float> xs, ys;
+        FillPoints(count, xs, ys);
+
+        SpatialGrid grid(cellSize);
+        grid.Build(xs.data(), ys.data(), count);
+
+        std::vector<int> candidates;
+        std::vector<int> seen(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            // Bullet-length steps in every direction, some crossing many cells
+            float x0 = xs[i];
+            float y0 = ys[i];
+            float x1 = x0 + std::cos(i * 0.37f) * (20.0f + (i % 9) * 60.0f);
+            float y1 = y0 + std::sin(i * 0.37f) * (20.0f + (i % 9) * 60.0f);
+            candidates.clear();
+            grid.QuerySegment(x0, y0, x1, y1, radius, candidates);
+            for (int index : candidates) {
+                seen[index]++;
+            }
+            for (size_t j = 0; j < count; ++j) {
+                if (NearSegment(xs[j], ys[j], x0, y0, x1, y1, radius)) {
+                    Check(seen[j] > 0, "QuerySegment missed a point", count, i);
+                }
+            }
+            for (int index : candidates) {
+                seen[index] = 0;
+            }
+        }
+    }
+}
+
+int main() {
+    const size_t counts[] = {250, 1000, 5000};
+    for (size_t count : counts) {
+        TestQuery(count);
+        TestQuerySegment(count);
+    }
+
+    if (failures > 0) {
+        std::printf("spatialgrid_test: %d failures\n", failures);
+        return 1;
+    }
+    std::printf("spatialgrid_test: OK\n");
+    return 0;
+}
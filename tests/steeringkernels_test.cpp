@@ -0,0 +1,93 @@
+// Checks every SIMD steering kernel this CPU supports against the scalar one, including the
+// leftover lanes that do not fill a whole vector and ranges that start mid-batch.
+#include "SteeringKernels.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    int failures = 0;
+
+    // Fixed pseudo-random mix of lanes, including empty neighbor sets and zero vectors,
+    // so every branch of the scalar kernel is exercised
+    void FillBatch(SteeringBatch& batch, size_t lanes) {
+        batch.Resize(lanes);
+        uint32_t state = 12345u;
+        auto next = [&state](float minValue, float maxValue) {
+            state = state * 1664525u + 1013904223u;
+            return minValue + (state >> 8) * (1.0f / 16777216.0f) * (maxValue - minValue);
+        };
+        for (size_t i = 0; i < lanes; ++i) {
+            batch.slot[i] = static_cast<int>(i);
+            batch.posX[i] = next(-3000.0f, 3000.0f);
+            batch.posY[i] = next(-3000.0f, 3000.0f);
+            batch.baseX[i] = (i % 7 == 0) ? 0.0f : next(-1.0f, 1.0f);
+            batch.baseY[i] = (i % 7 == 0) ? 0.0f : next(-1.0f, 1.0f);
+            batch.sepCount[i] = static_cast<float>(i % 4);
+            batch.sepX[i] = batch.sepCount[i] > 0 ? next(-3.0f, 3.0f) : 0.0f;
+            batch.sepY[i] = batch.sepCount[i] > 0 ? next(-3.0f, 3.0f) : 0.0f;
+            batch.aliCount[i] = static_cast<float>(i % 5);
+            batch.aliX[i] = batch.aliCount[i] > 0 ? next(-4.0f, 4.0f) : 0.0f;
+            batch.aliY[i] = batch.aliCount[i] > 0 ? next(-4.0f, 4.0f) : 0.0f;
+            batch.cohCount[i] = batch.aliCount[i];
+            batch.cohX[i] = batch.posX[i] * batch.cohCount[i] + next(-90.0f, 90.0f);
+            batch.cohY[i] = batch.posY[i] * batch.cohCount[i] + next(-90.0f, 90.0f);
+            batch.speed[i] = next(80.0f, 130.0f);
+        }
+        // Idle lanes must stay put in every kernel
+        for (size_t i = 5; i < lanes; i += 11) {
+            batch.SetIdle(i);
+        }
+    }
+
+    // Runs the kernel and the scalar one over [begin, end) of the same batch; lanes outside
+    // the range must be left untouched
+    void Compare(const char* name, SteeringKernels::CombineFunc kernel, size_t lanes, size_t begin, size_t end) {
+        const SteeringWeights weights = {1.2f, 1.5f, 1.0f, 1.0f};
+        const float deltaTime = 1.0f / 60.0f;
+
+        SteeringBatch expected, actual;
+        FillBatch(expected, lanes);
+        FillBatch(actual, lanes);
+        SteeringKernels::CombineScalar(expected, begin, end, deltaTime, weights);
+        kernel(actual, begin, end, deltaTime, weights);
+
+        for (size_t i = 0; i < lanes; ++i) {
+            if (std::fabs(expected.posX[i] - actual.posX[i]) > 1e-3f ||
+                std::fabs(expected.posY[i] - actual.posY[i]) > 1e-3f) {
+                if (failures < 20) {
+                    std::printf("FAIL %s lane %zu of [%zu, %zu): (%f, %f) vs scalar (%f, %f)\n", name, i, begin, end,
+                                actual.posX[i], actual.posY[i], expected.posX[i], expected.posY[i]);
+                }
+                ++failures;
+            }
+        }
+    }
+}
+
+int main() {
+    const char* const names[] = {"SSE2", "AVX2"};
+    for (const char* name : names) {
+        SteeringKernels::CombineFunc kernel = SteeringKernels::Find(name);
+        if (kernel == nullptr) {
+            std::printf("steeringkernels_test: %s not supported here, skipped\n", name);
+            continue;
+        }
+        // Every lane count up to a few vectors, so each tail length (1-7 lanes) runs
+        for (size_t lanes = 0; lanes <= 35; ++lanes) {
+            Compare(name, kernel, lanes, 0, lanes);
+        }
+        // Ranges that start off a vector boundary, like a worker's chunk of the batch
+        for (size_t begin = 1; begin < 9; ++begin) {
+            Compare(name, kernel, 67, begin, 67);
+            Compare(name, kernel, 67, begin, 67 - begin);
+        }
+    }
+
+    if (failures > 0) {
+        std::printf("steeringkernels_test: %d failures\n", failures);
+        return 1;
+    }
+    std::printf("steeringkernels_test: OK (selected %s)\n", SteeringKernels::GetSelectedName());
+    return 0;
+}